@@ -0,0 +1,706 @@
+﻿
+/**
+ * @file lv_bindings_bench.c
+ * @brief LVGL 绑定层主机端基准测试（Linux，无显示设备）
+ * @author Sab1e
+ * @date 2026-10-18
+ *
+ * 链接 LVGL（使用空刷新驱动）、JerryScript、由 ElenaOS_PC_Simulator 配置生成的
+ * src/lv_bindings.c 以及 src/lv_bindings_misc.c，测量：
+ *  - 按参数类型（number / string / object / color）的单次绑定调用开销
+ *  - 经过 lv_event_handler 的事件分发延迟
+ *  - js_lv_timer_create 定时器的触发抖动
+ *  - lv_binding_init 的耗时与堆占用
+ *  - 控件创建/删除吞吐量
+ *  - 应用切换时逐项释放与销毁绑定上下文的耗时对比
+ *  - 跨线程消息队列的多生产者压力测试（送达数量与每个生产者内的顺序）
+ *  - Promise 任务的调度延迟与看门狗中止死循环回调的耗时
+ *  - 逐个读取控件值与批量查询接口的耗时对比
+ * 结果以 JSON 写入文件，便于在提交之间比较回归。使用 --trace 生成绑定时，
+ * 另将整个运行过程的调用追踪写入 bench_trace.json（Chrome trace-event 格式）。
+ *
+ * 构建与运行（路径按实际工程调整，详见 bench/Makefile）：
+ *   python gen_lvgl_binding.py --cfg-path=examples/ElenaOS_PC_Simulator/ --json-file=<lvgl.json>
+ *   make -C bench LVGL_DIR=<lvgl> JERRY_DIR=<jerryscript> SIM_INC=<simulator>/inc run
+ * 直接运行：
+ *   bench/lv_bindings_bench [输出文件，默认 bench_output.json] [版本标签]
+ */
+
+#define _POSIX_C_SOURCE 199309L
+#include "lv_bindings.h"
+#include "lv_bindings_misc.h"
+#include "lv_bindings_msgq.h"
+#include "lv_bindings_sched.h"
+#include "lv_bindings_trace.h"
+#include "lvgl.h"
+#include "jerryscript.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/********************************** 配置 **********************************/
+#define BENCH_HOR_RES 320
+#define BENCH_VER_RES 240
+#define BENCH_CALL_ITERATIONS 20000
+#define BENCH_EVENT_ITERATIONS 20000
+#define BENCH_WIDGET_ITERATIONS 2000
+#define BENCH_TIMER_PERIOD_MS 10
+#define BENCH_TIMER_SAMPLES 200
+#define BENCH_APP_RESOURCES 200
+#define BENCH_MSGQ_PRODUCERS 4
+#define BENCH_MSGQ_MESSAGES 20000 // 每个生产者
+#define BENCH_WATCHDOG_LIMIT_MS 50
+#define BENCH_BULK_WIDGETS 200
+#define BENCH_BULK_ROUNDS 50
+
+/********************************** 计时辅助函数 **********************************/
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t bench_tick_cb(void)
+{
+    return (uint32_t)(bench_now_ns() / 1000000ull);
+}
+
+static void bench_sleep_us(uint32_t us)
+{
+    struct timespec ts = {.tv_sec = us / 1000000u, .tv_nsec = (long)(us % 1000000u) * 1000l};
+    nanosleep(&ts, NULL);
+}
+
+/********************************** 空刷新驱动 **********************************/
+static uint8_t bench_draw_buf[BENCH_HOR_RES * 20 * 4];
+
+static void bench_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+    lv_display_flush_ready(disp);
+}
+
+static void bench_lvgl_init(void)
+{
+    lv_init();
+    lv_tick_set_cb(bench_tick_cb);
+    lv_display_t *disp = lv_display_create(BENCH_HOR_RES, BENCH_VER_RES);
+    lv_display_set_flush_cb(disp, bench_flush_cb);
+    lv_display_set_buffers(disp, bench_draw_buf, NULL, sizeof(bench_draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+}
+
+/********************************** JS 辅助函数 **********************************/
+/**
+ * @brief 执行一段脚本，出错时打印并返回 false
+ */
+static bool bench_eval(const char *source)
+{
+    jerry_value_t ret = jerry_eval((const jerry_char_t *)source, strlen(source), JERRY_PARSE_NO_OPTS);
+    bool ok = !jerry_value_is_exception(ret);
+    if (!ok)
+    {
+        fprintf(stderr, "[bench] script failed: %s\n", source);
+    }
+    jerry_value_free(ret);
+    return ok;
+}
+
+/**
+ * @brief 执行脚本并返回耗时（纳秒），失败返回 0
+ */
+static uint64_t bench_eval_timed(const char *source)
+{
+    uint64_t start = bench_now_ns();
+    if (!bench_eval(source))
+    {
+        return 0;
+    }
+    return bench_now_ns() - start;
+}
+
+/**
+ * @brief 执行脚本并返回数值结果，失败返回 -1
+ */
+static double bench_eval_number(const char *source)
+{
+    jerry_value_t ret = jerry_eval((const jerry_char_t *)source, strlen(source), JERRY_PARSE_NO_OPTS);
+    double value = jerry_value_is_number(ret) ? jerry_value_as_number(ret) : -1;
+    jerry_value_free(ret);
+    return value;
+}
+
+static size_t bench_jerry_heap_used(void)
+{
+    jerry_heap_stats_t stats = {0};
+    if (!jerry_heap_stats(&stats))
+    {
+        return 0;
+    }
+    return stats.allocated_bytes;
+}
+
+static size_t bench_lvgl_heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+/********************************** 定时器抖动采样 **********************************/
+static uint64_t timer_samples[BENCH_TIMER_SAMPLES];
+static uint32_t timer_sample_count = 0;
+
+/**
+ * @brief 供脚本调用的打点函数，记录定时器回调触发时刻
+ */
+static jerry_value_t bench_mark(const jerry_call_info_t *call_info_p,
+                                const jerry_value_t args[],
+                                const jerry_length_t argc)
+{
+    (void)call_info_p;
+    (void)args;
+    (void)argc;
+    if (timer_sample_count < BENCH_TIMER_SAMPLES)
+    {
+        timer_samples[timer_sample_count++] = bench_now_ns();
+    }
+    return jerry_undefined();
+}
+
+/********************************** 应用切换 **********************************/
+static LVBindingContext_t *bench_app_ctx = NULL;
+
+/**
+ * @brief 供脚本调用：销毁 bench_app_ctx，使两种释放方式都从脚本发起计时
+ */
+static jerry_value_t bench_ctx_destroy(const jerry_call_info_t *call_info_p,
+                                       const jerry_value_t args[],
+                                       const jerry_length_t argc)
+{
+    (void)call_info_p;
+    (void)args;
+    (void)argc;
+    if (bench_app_ctx)
+    {
+        lv_binding_ctx_destroy(bench_app_ctx);
+        bench_app_ctx = NULL;
+    }
+    return jerry_undefined();
+}
+
+static const LVBindingJerryscriptFuncEntry_t bench_funcs[] = {
+    {"__bench_mark", bench_mark},
+    {"__bench_ctx_destroy", bench_ctx_destroy}};
+
+/********************************** 测量项 **********************************/
+typedef struct
+{
+    const char *name;
+    const char *setup;
+    const char *body;
+} bench_call_case_t;
+
+// 每项用例在同一循环内重复调用，减去空循环耗时得到单次调用开销
+static const bench_call_case_t call_cases[] = {
+    {"number", "var o = lv_obj_create(lv_scr_act());", "lv_obj_set_width(o, 10);"},
+    {"string", "var o = lv_label_create(lv_scr_act());", "lv_label_set_text(o, 'bench');"},
+    {"object", "var o = lv_obj_create(lv_scr_act());", "lv_obj_center(o);"},
+    {"color", "var o = lv_obj_create(lv_scr_act());", "lv_obj_set_style_bg_color(o, 0x3366ff, 0);"},
+};
+
+static double bench_call_overhead_ns(const bench_call_case_t *c, uint64_t empty_loop_ns)
+{
+    char script[512];
+    if (!bench_eval(c->setup))
+    {
+        return -1;
+    }
+    snprintf(script, sizeof(script), "for (var i = 0; i < %d; i++) { %s }", BENCH_CALL_ITERATIONS, c->body);
+    uint64_t elapsed = bench_eval_timed(script);
+    bench_eval("lv_obj_del(o);");
+    if (elapsed == 0)
+    {
+        return -1;
+    }
+    if (elapsed > empty_loop_ns)
+    {
+        elapsed -= empty_loop_ns;
+    }
+    return (double)elapsed / BENCH_CALL_ITERATIONS;
+}
+
+static double bench_event_latency_ns(void)
+{
+    if (!bench_eval("var ev_obj = lv_obj_create(lv_scr_act());"
+                    "var ev_count = 0;"
+                    "register_lv_event_handler(ev_obj, LV_EVENT_CLICKED, function (e) { ev_count++; });"))
+    {
+        return -1;
+    }
+
+    jerry_value_t global = jerry_current_realm();
+    jerry_value_t name = jerry_string_sz("ev_obj");
+    jerry_value_t wrapper = jerry_object_get(global, name);
+    jerry_value_free(name);
+    name = jerry_string_sz("__ptr");
+    jerry_value_t ptr_val = jerry_object_get(wrapper, name);
+    jerry_value_free(name);
+    lv_obj_t *obj = (lv_obj_t *)(uintptr_t)jerry_value_as_number(ptr_val);
+    jerry_value_free(ptr_val);
+    jerry_value_free(wrapper);
+    jerry_value_free(global);
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < BENCH_EVENT_ITERATIONS; i++)
+    {
+        lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    bench_eval("unregister_lv_event_handler(ev_obj, LV_EVENT_CLICKED); lv_obj_del(ev_obj);");
+    return (double)elapsed / BENCH_EVENT_ITERATIONS;
+}
+
+static void bench_timer_jitter(double *mean_us, double *max_us)
+{
+    *mean_us = -1;
+    *max_us = -1;
+    timer_sample_count = 0;
+
+    char script[256];
+    snprintf(script, sizeof(script),
+             "var bench_timer = lv_timer_create(function () { __bench_mark(); }, %d);", BENCH_TIMER_PERIOD_MS);
+    if (!bench_eval(script))
+    {
+        return;
+    }
+
+    uint64_t deadline = bench_now_ns() + (uint64_t)BENCH_TIMER_PERIOD_MS * (BENCH_TIMER_SAMPLES + 50) * 1000000ull;
+    while (timer_sample_count < BENCH_TIMER_SAMPLES && bench_now_ns() < deadline)
+    {
+        lv_timer_handler();
+        bench_sleep_us(200);
+    }
+    bench_eval("lv_timer_delete(bench_timer);");
+
+    if (timer_sample_count < 2)
+    {
+        return;
+    }
+
+    double sum = 0, max = 0;
+    for (uint32_t i = 1; i < timer_sample_count; i++)
+    {
+        double interval_us = (double)(timer_samples[i] - timer_samples[i - 1]) / 1000.0;
+        double deviation = interval_us - BENCH_TIMER_PERIOD_MS * 1000.0;
+        if (deviation < 0)
+        {
+            deviation = -deviation;
+        }
+        sum += deviation;
+        if (deviation > max)
+        {
+            max = deviation;
+        }
+    }
+    *mean_us = sum / (timer_sample_count - 1);
+    *max_us = max;
+}
+
+/**
+ * @brief 模拟一个应用：每个对象注册一个事件回调、一个定时器和一个样式
+ */
+static bool bench_setup_app(void)
+{
+    char script[512];
+    snprintf(script, sizeof(script),
+             "var app_objs = [], app_timers = [], app_styles = [];"
+             "for (var i = 0; i < %d; i++) {"
+             "  var o = lv_obj_create(lv_scr_act());"
+             "  register_lv_event_handler(o, LV_EVENT_CLICKED, function (e) { });"
+             "  app_objs.push(o);"
+             "  app_timers.push(lv_timer_create(function () { }, 100000));"
+             "  var s = {}; lv_style_init(s); app_styles.push(s);"
+             "}",
+             BENCH_APP_RESOURCES);
+    return bench_eval(script);
+}
+
+static void bench_teardown_app_objects(void)
+{
+    bench_eval("for (var i = 0; i < app_objs.length; i++) { lv_obj_del(app_objs[i]); }"
+               "app_objs = app_timers = app_styles = undefined;");
+}
+
+/**
+ * @brief 应用切换耗时：逐项注销（切换前的做法）与销毁绑定上下文对比
+ *
+ * 两条路径都通过 bench_eval_timed 从脚本发起，计入相同的解析与调用开销；
+ * 控件均在释放完成后再删除。
+ */
+static void bench_app_switch(double *manual_us, double *ctx_us)
+{
+    *manual_us = -1;
+    *ctx_us = -1;
+
+    if (bench_setup_app())
+    {
+        uint64_t elapsed = bench_eval_timed(
+            "for (var i = 0; i < app_objs.length; i++) {"
+            "  unregister_lv_event_handler(app_objs[i], LV_EVENT_CLICKED);"
+            "  lv_timer_delete(app_timers[i]);"
+            "  lv_style_delete(app_styles[i]);"
+            "}");
+        if (elapsed)
+        {
+            *manual_us = (double)elapsed / 1000.0;
+        }
+        bench_teardown_app_objects();
+    }
+
+    bench_app_ctx = lv_binding_ctx_create();
+    LVBindingContext_t *prev = lv_binding_ctx_set_current(bench_app_ctx);
+    bool ok = bench_setup_app();
+    lv_binding_ctx_set_current(prev);
+
+    uint64_t elapsed = bench_eval_timed("__bench_ctx_destroy();");
+    if (ok && elapsed)
+    {
+        *ctx_us = (double)elapsed / 1000.0;
+    }
+    if (bench_app_ctx)
+    {
+        lv_binding_ctx_destroy(bench_app_ctx);
+        bench_app_ctx = NULL;
+    }
+    if (ok)
+    {
+        bench_teardown_app_objects();
+    }
+}
+
+/**
+ * @brief 生产者线程：按序投递消息，队列满时让出 CPU 后重试
+ */
+static void *bench_msgq_producer(void *arg)
+{
+    uint32_t topic = (uint32_t)(uintptr_t)arg;
+    for (uint32_t i = 0; i < BENCH_MSGQ_MESSAGES; i++)
+    {
+        if (topic & 1)
+        {
+            while (!lv_binding_msgq_post_number(topic, i))
+                sched_yield();
+        }
+        else
+        {
+            uint8_t payload[4] = {(uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 16), (uint8_t)(i >> 24)};
+            while (!lv_binding_msgq_post_bytes(topic, payload, sizeof(payload)))
+                sched_yield();
+        }
+    }
+    return NULL;
+}
+
+typedef struct
+{
+    double delivered;
+    double order_errors;
+    double elapsed_ms;
+    uint32_t full_retries;
+} bench_msgq_result_t;
+
+/**
+ * @brief 跨线程消息队列压力测试：多个生产者线程并发投递，UI 线程经 lv_timer 送达 JS
+ */
+static bench_msgq_result_t bench_msgq_stress(void)
+{
+    bench_msgq_result_t result = {-1, -1, -1, 0};
+    if (!bench_eval("var mq_last = [], mq_recv = 0, mq_errors = 0;"
+                    "for (var i = 0; i < 32; i++) mq_last.push(-1);"
+                    "lv_msgq_set_budget(256);"
+                    "lv_msgq_set_handler(function (topic, v) {"
+                    "  if (typeof v !== 'number') { var b = new Uint8Array(v); v = b[0] | (b[1] << 8) | (b[2] << 16) | (b[3] << 24); }"
+                    "  if (v !== mq_last[topic] + 1) mq_errors++;"
+                    "  mq_last[topic] = v; mq_recv++;"
+                    "});"))
+    {
+        return result;
+    }
+
+    uint32_t dropped_before = lv_binding_msgq_get_dropped();
+    pthread_t producers[BENCH_MSGQ_PRODUCERS];
+    uint64_t start = bench_now_ns();
+    for (uintptr_t i = 0; i < BENCH_MSGQ_PRODUCERS; i++)
+    {
+        pthread_create(&producers[i], NULL, bench_msgq_producer, (void *)i);
+    }
+
+    const double total = (double)BENCH_MSGQ_PRODUCERS * BENCH_MSGQ_MESSAGES;
+    uint64_t deadline = start + 30ull * 1000000000ull;
+    while (bench_eval_number("mq_recv") < total && bench_now_ns() < deadline)
+    {
+        lv_timer_handler();
+        bench_sleep_us(100);
+    }
+    result.elapsed_ms = (double)(bench_now_ns() - start) / 1e6;
+
+    for (int i = 0; i < BENCH_MSGQ_PRODUCERS; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+
+    result.delivered = bench_eval_number("mq_recv");
+    result.order_errors = bench_eval_number("mq_errors");
+    result.full_retries = lv_binding_msgq_get_dropped() - dropped_before;
+    bench_eval("lv_msgq_set_handler(undefined); lv_msgq_set_budget(32);");
+    return result;
+}
+
+typedef struct
+{
+    double promise_latency_us;
+    double watchdog_elapsed_ms;
+    bool watchdog_aborted;
+} bench_sched_result_t;
+
+static LVBindingOverrunInfo_t bench_overrun;
+static bool bench_overrun_seen = false;
+
+static void bench_overrun_cb(const LVBindingOverrunInfo_t *info, void *user_data)
+{
+    (void)user_data;
+    bench_overrun = *info;
+    bench_overrun_seen = true;
+}
+
+/**
+ * @brief JS 调度：lv_timer_delay(0) 从创建到 then 回调执行的延迟，以及看门狗中止死循环定时器回调的耗时
+ */
+static bench_sched_result_t bench_sched(void)
+{
+    bench_sched_result_t result = {-1, -1, false};
+
+    uint64_t start = bench_now_ns();
+    if (bench_eval("var sched_done = false; lv_timer_delay(0).then(function () { sched_done = true; });"))
+    {
+        uint64_t deadline = start + 1000000000ull;
+        while (bench_eval_number("sched_done ? 1 : 0") != 1 && bench_now_ns() < deadline)
+        {
+            lv_timer_handler();
+        }
+        if (bench_eval_number("sched_done ? 1 : 0") == 1)
+        {
+            result.promise_latency_us = (double)(bench_now_ns() - start) / 1000.0;
+        }
+    }
+
+    uint32_t prev_limit = lv_binding_get_watchdog_limit();
+    lv_binding_set_watchdog_limit(BENCH_WATCHDOG_LIMIT_MS);
+    lv_binding_set_overrun_cb(bench_overrun_cb, NULL);
+    bench_overrun_seen = false;
+    if (bench_eval("var sched_spin = lv_timer_create(function spin() { while (true) { } }, 1);"))
+    {
+        uint64_t deadline = bench_now_ns() + 5000000000ull;
+        while (!bench_overrun_seen && bench_now_ns() < deadline)
+        {
+            lv_timer_handler();
+            bench_sleep_us(200);
+        }
+        bench_eval("lv_timer_delete(sched_spin);");
+        if (bench_overrun_seen)
+        {
+            result.watchdog_elapsed_ms = bench_overrun.elapsed_ms;
+            result.watchdog_aborted = bench_overrun.aborted;
+        }
+    }
+    lv_binding_set_overrun_cb(NULL, NULL);
+    lv_binding_set_watchdog_limit(prev_limit);
+    return result;
+}
+
+typedef struct
+{
+    double per_item_us;
+    double bulk_array_us;
+    double bulk_i32_us;
+} bench_bulk_result_t;
+
+/**
+ * @brief 读取一组滑块的值：逐个调用 lv_slider_get_value 与一次调用批量接口对比（每轮耗时）
+ */
+static bench_bulk_result_t bench_bulk_query(void)
+{
+    bench_bulk_result_t result = {-1, -1, -1};
+    char script[256];
+    snprintf(script, sizeof(script),
+             "var bulk_parent = lv_obj_create(lv_scr_act()), bulk_sliders = [];"
+             "for (var i = 0; i < %d; i++) { var s = lv_slider_create(bulk_parent); lv_slider_set_value(s, i, 0); bulk_sliders.push(s); }",
+             BENCH_BULK_WIDGETS);
+    if (!bench_eval(script))
+    {
+        return result;
+    }
+
+    static const char *const cases[] = {
+        "for (var r = 0; r < %d; r++) { var v = []; for (var i = 0; i < bulk_sliders.length; i++) v.push(lv_slider_get_value(bulk_sliders[i])); }",
+        "for (var r = 0; r < %d; r++) { var v = lv_obj_get_values(lv_obj_get_children(bulk_parent)); }",
+        "for (var r = 0; r < %d; r++) { var v = lv_obj_get_values_i32(bulk_sliders); }",
+    };
+    double *outputs[] = {&result.per_item_us, &result.bulk_array_us, &result.bulk_i32_us};
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        snprintf(script, sizeof(script), cases[i], BENCH_BULK_ROUNDS);
+        uint64_t elapsed = bench_eval_timed(script);
+        if (elapsed)
+        {
+            *outputs[i] = (double)elapsed / 1000.0 / BENCH_BULK_ROUNDS;
+        }
+    }
+
+    bench_eval("lv_obj_del(bulk_parent); bulk_parent = bulk_sliders = undefined;");
+    return result;
+}
+
+/********************************** 输出辅助函数 **********************************/
+/**
+ * @brief 以 JSON 字符串格式写出文本（转义引号、反斜杠和控制字符）
+ */
+static void bench_write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+    {
+        if (*p == '"' || *p == '\\')
+        {
+            fprintf(out, "\\%c", *p);
+        }
+        else if (*p < 0x20)
+        {
+            fprintf(out, "\\u%04x", *p);
+        }
+        else
+        {
+            fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/********************************** 主函数 **********************************/
+int main(int argc, char **argv)
+{
+    const char *output_path = argc > 1 ? argv[1] : "bench_output.json";
+    const char *label = argc > 2 ? argv[2] : "";
+
+    bench_lvgl_init();
+    jerry_init(JERRY_INIT_EMPTY);
+
+    // lv_binding_init 耗时与堆占用
+    size_t jerry_heap_before = bench_jerry_heap_used();
+    size_t lvgl_heap_before = bench_lvgl_heap_used();
+    uint64_t init_start = bench_now_ns();
+    lv_binding_init();
+    uint64_t init_ns = bench_now_ns() - init_start;
+    size_t jerry_heap_init = bench_jerry_heap_used() - jerry_heap_before;
+    size_t lvgl_heap_init = bench_lvgl_heap_used() - lvgl_heap_before;
+
+    lv_binding_jerryscript_register_functions(bench_funcs, sizeof(bench_funcs) / sizeof(LVBindingJerryscriptFuncEntry_t));
+
+    // 单次调用开销
+    char empty_loop[128];
+    snprintf(empty_loop, sizeof(empty_loop), "for (var i = 0; i < %d; i++) { }", BENCH_CALL_ITERATIONS);
+    uint64_t empty_loop_ns = bench_eval_timed(empty_loop);
+
+    size_t call_case_count = sizeof(call_cases) / sizeof(call_cases[0]);
+    double call_ns[sizeof(call_cases) / sizeof(call_cases[0])];
+    for (size_t i = 0; i < call_case_count; i++)
+    {
+        call_ns[i] = bench_call_overhead_ns(&call_cases[i], empty_loop_ns);
+    }
+
+    // 事件分发延迟
+    double event_ns = bench_event_latency_ns();
+
+    // 定时器抖动
+    double jitter_mean_us, jitter_max_us;
+    bench_timer_jitter(&jitter_mean_us, &jitter_max_us);
+
+    // 控件创建/删除吞吐量
+    char widget_script[160];
+    snprintf(widget_script, sizeof(widget_script),
+             "for (var i = 0; i < %d; i++) { lv_obj_del(lv_label_create(lv_scr_act())); }", BENCH_WIDGET_ITERATIONS);
+    uint64_t widget_ns = bench_eval_timed(widget_script);
+    double widget_ops = widget_ns ? (double)BENCH_WIDGET_ITERATIONS * 1e9 / (double)widget_ns : -1;
+
+    // 应用切换
+    double switch_manual_us, switch_ctx_us;
+    bench_app_switch(&switch_manual_us, &switch_ctx_us);
+
+    // 跨线程消息队列压力测试
+    bench_msgq_result_t msgq = bench_msgq_stress();
+
+    // JS 调度与看门狗
+    bench_sched_result_t sched = bench_sched();
+
+    // 批量查询
+    bench_bulk_result_t bulk = bench_bulk_query();
+
+    FILE *out = fopen(output_path, "w");
+    if (!out)
+    {
+        fprintf(stderr, "[bench] cannot open %s\n", output_path);
+        jerry_cleanup();
+        return 1;
+    }
+    fprintf(out, "{\n");
+    fprintf(out, "  \"label\": ");
+    bench_write_json_string(out, label);
+    fprintf(out, ",\n");
+    fprintf(out, "  \"binding_init\": {\"time_us\": %.1f, \"jerry_heap_bytes\": %zu, \"lvgl_heap_bytes\": %zu},\n",
+            (double)init_ns / 1000.0, jerry_heap_init, lvgl_heap_init);
+    fprintf(out, "  \"call_overhead_ns\": {");
+    for (size_t i = 0; i < call_case_count; i++)
+    {
+        fprintf(out, "%s\"%s\": %.1f", i ? ", " : "", call_cases[i].name, call_ns[i]);
+    }
+    fprintf(out, "},\n");
+    fprintf(out, "  \"event_dispatch_ns\": %.1f,\n", event_ns);
+    fprintf(out, "  \"timer_jitter_us\": {\"period_ms\": %d, \"samples\": %u, \"mean\": %.1f, \"max\": %.1f},\n",
+            BENCH_TIMER_PERIOD_MS, timer_sample_count, jitter_mean_us, jitter_max_us);
+    fprintf(out, "  \"widget_create_delete_per_sec\": %.1f,\n", widget_ops);
+    fprintf(out, "  \"app_switch_us\": {\"resources\": %d, \"per_resource_teardown\": %.1f, \"ctx_destroy\": %.1f},\n",
+            BENCH_APP_RESOURCES, switch_manual_us, switch_ctx_us);
+    fprintf(out, "  \"msgq_stress\": {\"producers\": %d, \"messages\": %d, \"delivered\": %.0f, \"order_errors\": %.0f, "
+                 "\"full_retries\": %u, \"elapsed_ms\": %.1f},\n",
+            BENCH_MSGQ_PRODUCERS, BENCH_MSGQ_PRODUCERS * BENCH_MSGQ_MESSAGES, msgq.delivered, msgq.order_errors,
+            msgq.full_retries, msgq.elapsed_ms);
+    fprintf(out, "  \"sched\": {\"promise_latency_us\": %.1f, \"watchdog_limit_ms\": %d, \"watchdog_elapsed_ms\": %.1f, "
+                 "\"watchdog_aborted\": %s},\n",
+            sched.promise_latency_us, BENCH_WATCHDOG_LIMIT_MS, sched.watchdog_elapsed_ms,
+            sched.watchdog_aborted ? "true" : "false");
+    fprintf(out, "  \"bulk_query_us\": {\"widgets\": %d, \"per_item\": %.1f, \"bulk_array\": %.1f, \"bulk_i32\": %.1f}\n",
+            BENCH_BULK_WIDGETS, bulk.per_item_us, bulk.bulk_array_us, bulk.bulk_i32_us);
+    fprintf(out, "}\n");
+    fclose(out);
+
+    printf("[bench] results written to %s\n", output_path);
+#if LV_BINDING_TRACE && LV_BINDING_TRACE_USE_STDIO
+    printf("[bench] %d trace events written to bench_trace.json\n", (int)lv_binding_trace_dump("bench_trace.json"));
+#endif
+    jerry_cleanup();
+
+    // 消息丢失或乱序时以非零值退出，便于在 CI 中发现回归
+    if (msgq.delivered != (double)BENCH_MSGQ_PRODUCERS * BENCH_MSGQ_MESSAGES || msgq.order_errors != 0)
+    {
+        fprintf(stderr, "[bench] msgq stress failed: delivered %.0f of %d, %.0f order errors\n", msgq.delivered,
+                BENCH_MSGQ_PRODUCERS * BENCH_MSGQ_MESSAGES, msgq.order_errors);
+        return 1;
+    }
+    return 0;
+}
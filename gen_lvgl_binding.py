@@ -4,6 +4,15 @@ from datetime import date
 import sys
 from colorama import init, Fore, Style
 import fnmatch
+import hashlib
+import pickle
+import re
+import io
+import contextlib
+import shlex
+import shutil
+import subprocess
+import tempfile
 
 # 配置路径
 script_dir = os.path.dirname(os.path.abspath(__file__))
@@ -19,6 +28,30 @@ blacklist_macros_path = os.path.join(script_dir, "blacklist_macros.txt")
 extract_funcs_from = None
 print_all_info = False
 print_macro_info = False
+# lvgl.json 解析缓存目录（按文件内容哈希命名）
+json_cache_dir = os.path.join(script_dir, '.lvgl_json_cache')
+use_json_cache = True
+# 缓存格式版本，修改 build_lvgl_index 的索引结构时需递增，使旧缓存失效
+JSON_CACHE_FORMAT = 1
+# 按控件族拆分输出的绑定单元文件名前缀
+UNIT_FILE_PREFIX = 'lv_bindings_gen_'
+# 生成的编译配置头文件，写入 inc/ 使 lv_bindings_trace.h 与各源文件包含的是同一份
+GEN_CONF_FILE = 'lv_bindings_gen_conf.h'
+gen_conf_dir = os.path.join(script_dir, 'inc')
+# 由 lv_bindings_misc.c 手写实现的绑定，摇树时无需再生成
+misc_bindings_file = os.path.join(script_dir, 'src', 'lv_bindings_misc.c')
+# 摇树模式扫描的应用目录
+shake_app_dir = None
+# 摇树报告编译目标文件时附加的编译参数（LVGL、JerryScript 等头文件路径）
+shake_cflags = ''
+# 摇树报告引用的基准测试结果（完整生成、摇树生成各一份 bench_output.json）
+shake_bench_files = None
+# lv_bindings_misc.c 中注册的 Montserrat 字号
+MONTSERRAT_FONT_SIZES = list(range(8, 50, 2))
+# 为每个绑定生成调用追踪探针（lv_bindings_trace.h）
+trace_bindings = False
+# 生成的绑定的追踪编号起点，与 lv_bindings_trace.h 中的 LV_BINDING_TRACE_ID_GENERATED 一致
+TRACE_ID_BASE_MACRO = 'LV_BINDING_TRACE_ID_GENERATED'
 # 目标代码的固定部分
 HEADER_CODE = r"""
 /**
@@ -37,12 +70,6 @@ HEADER_CODE = r"""
 #include <stdlib.h>
 #include <string.h>
 
-/********************************** 错误处理辅助函数 **********************************/
-static jerry_value_t throw_error(const char* message) {
-    jerry_value_t error_obj = jerry_error_sz(JERRY_ERROR_TYPE, (const jerry_char_t*)message);
-    return jerry_throw_value(error_obj, true);
-}
-
 /********************************** 宏定义处理辅助函数 **********************************/
 
 static void lvgl_binding_set_enum(jerry_value_t global, const char* key, int32_t val) {
@@ -55,6 +82,34 @@ static void lvgl_binding_set_enum(jerry_value_t global, const char* key, int32_t
 
 """
 
+# 绑定单元文件的固定部分（不含日期，内容不变时不重写文件）
+UNIT_HEADER_CODE = r"""
+/**
+ * @file {file_name}
+ * @brief 将 LVGL {family} 系列函数绑定到 JerryScript 的实现文件，此文件使用脚本自动生成。
+ * @author Sab1e
+ */
+// Application System header files
+#include "lv_bindings.h"
+#include "lv_bindings_misc.h"
+#include "script_engine_core.h"
+// Third party header files
+#include "jerryscript.h"
+#include "lvgl.h"
+#include <stdlib.h>
+#include <string.h>
+
+"""
+
+# 绑定单元的错误处理辅助函数，只输出到实际调用它的单元中，避免 -Wunused-function
+UNIT_THROW_ERROR_CODE = r"""/********************************** 错误处理辅助函数 **********************************/
+static jerry_value_t throw_error(const char* message) {
+    jerry_value_t error_obj = jerry_error_sz(JERRY_ERROR_TYPE, (const jerry_char_t*)message);
+    return jerry_throw_value(error_obj, true);
+}
+
+"""
+
 INIT_FUNCTION_CODE = r"""
 /********************************** 初始化 LVGL 绑定系统 **********************************/
 /**
@@ -153,44 +208,95 @@ def is_lvgl_value_type(type_str):
     """检查是否是LVGL值类型（非指针）"""
     return 'lv_' in type_str and '*' not in type_str
 
+def build_lvgl_index(data):
+    """为lvgl.json建立按名称查找的字典索引，避免逐项线性搜索"""
+    index = {
+        'functions': {},
+        'function_pointers': {},
+        'macro_initializers': {},
+        'enums': set(),
+        'typedefs': {},
+    }
+    # 同名条目只保留第一个，与原先线性搜索的结果一致
+    for func in data.get('functions', []):
+        index['functions'].setdefault(func['name'], func)
+    for func_ptr in data.get('function_pointers', []):
+        index['function_pointers'].setdefault(func_ptr['name'], func_ptr)
+    for macro in data.get('macros', []):
+        if macro.get('name') and 'initializer' in macro:
+            index['macro_initializers'].setdefault(macro['name'], []).append(macro['initializer'])
+    for enum in data.get('enums', []):
+        if enum and enum.get('name'):
+            index['enums'].add(enum['name'])
+    for typedef in data.get('typedefs', []):
+        index['typedefs'].setdefault(typedef['name'], typedef)
+    return index
+
+_lvgl_indices = {}
+
+def get_lvgl_index(data):
+    """获取lvgl.json数据对应的索引，首次使用时建立"""
+    index = _lvgl_indices.get(id(data))
+    if index is None:
+        index = build_lvgl_index(data)
+        _lvgl_indices[id(data)] = index
+    return index
+
+def load_lvgl_json(file_path):
+    """读取lvgl.json，按文件内容哈希缓存解析结果与索引"""
+    with open(file_path, 'rb') as f:
+        raw = f.read()
+    digest = hashlib.sha256(raw).hexdigest()
+    cache_file = os.path.join(json_cache_dir, f"{digest}.v{JSON_CACHE_FORMAT}.pickle")
+
+    if use_json_cache and os.path.exists(cache_file):
+        try:
+            with open(cache_file, 'rb') as f:
+                data, index = pickle.load(f)
+            _lvgl_indices[id(data)] = index
+            print(f"{Fore.GREEN}[缓存] 使用已解析的 lvgl.json 缓存: {cache_file}{Style.RESET_ALL}")
+            return data
+        except Exception as e:
+            print(f"{Fore.YELLOW}[警告] 读取缓存 {cache_file} 失败，重新解析: {str(e)}{Style.RESET_ALL}")
+
+    data = json.loads(raw)
+    index = get_lvgl_index(data)
+
+    if use_json_cache:
+        try:
+            os.makedirs(json_cache_dir, exist_ok=True)
+            # 只保留当前 lvgl.json 对应的缓存
+            for name in os.listdir(json_cache_dir):
+                if name.endswith('.pickle') and name != os.path.basename(cache_file):
+                    os.remove(os.path.join(json_cache_dir, name))
+            with open(cache_file, 'wb') as f:
+                pickle.dump((data, index), f, protocol=pickle.HIGHEST_PROTOCOL)
+        except OSError as e:
+            print(f"{Fore.YELLOW}[警告] 写入缓存 {cache_file} 失败: {str(e)}{Style.RESET_ALL}")
+    return data
+
 def is_enum_type(type_name, typedefs_data):
     """检查是否是枚举类型"""
-    for enum in typedefs_data.get('enums', []):
-        if enum['name'] == type_name:
-            return True
-    return False
+    return type_name in get_lvgl_index(typedefs_data)['enums']
 
 def is_typedef_convertible_to_basic(typedef_name, typedefs_data):
     """检查typedef是否可以转换为基本类型"""
-    if is_enum_type(typedef_name, typedefs_data):
-        return True
-        
-    for typedef in typedefs_data.get('typedefs', []):
-        if typedef['name'] == typedef_name:
-            base_type, type_info = parse_type(typedef['type'])
-            
-            if type_info.get('is_pointer') and type_info['base_type'].get('is_void'):
-                return True
-            
-            if type_info.get('is_primitive') or type_info.get('is_stdlib'):
-                return True
-                    
-    return False
+    return get_typedef_base_type(typedef_name, typedefs_data) is not None
 
 def get_typedef_base_type(typedef_name, typedefs_data):
     """获取typedef对应的基础类型"""
     if is_enum_type(typedef_name, typedefs_data):
         return 'int'
+
+    typedef = get_lvgl_index(typedefs_data)['typedefs'].get(typedef_name)
+    if typedef:
+        base_type, type_info = parse_type(typedef['type'])
         
-    for typedef in typedefs_data.get('typedefs', []):
-        if typedef['name'] == typedef_name:
-            base_type, type_info = parse_type(typedef['type'])
-            
-            if type_info.get('is_pointer') and type_info['base_type'].get('is_void'):
-                return 'uintptr_t'
-            
-            if type_info.get('is_primitive') or type_info.get('is_stdlib'):
-                return base_type
+        if type_info.get('is_pointer') and type_info['base_type'].get('is_void'):
+            return 'uintptr_t'
+        
+        if type_info.get('is_primitive') or type_info.get('is_stdlib'):
+            return base_type
             
     return None
 
@@ -488,38 +594,29 @@ def find_real_function_definition(func_name, data):
     查找函数的真实定义，处理宏定义的情况
     返回 (真实函数名, 函数定义, is_macro)
     """
+    index = get_lvgl_index(data)
+
     # 首先检查是否是宏定义
-    for macro in data.get('macros', []):
-        if macro['name'] == func_name and 'initializer' in macro:
-            # 提取宏定义的底层函数名
-            real_func_name = macro['initializer'].strip()
-            if real_func_name.endswith(';'):
-                real_func_name = real_func_name[:-1].strip()
-            
-            # 查找底层函数定义
-            for func in data.get('functions', []):
-                if func['name'] == real_func_name:
-                    return (real_func_name, func, True)
-            
-            # 如果没有找到函数定义，尝试查找函数指针
-            for func_ptr in data.get('function_pointers', []):
-                if func_ptr['name'] == real_func_name:
-                    return (real_func_name, func_ptr, True)
-    
-    # 如果不是宏定义，直接查找函数定义
-    for func in data.get('functions', []):
-        if func['name'] == func_name:
-            return (func_name, func, False)
+    for initializer in index['macro_initializers'].get(func_name, []):
+        # 提取宏定义的底层函数名
+        real_func_name = initializer.strip()
+        if real_func_name.endswith(';'):
+            real_func_name = real_func_name[:-1].strip()
+        
+        # 查找底层函数定义，如果没有找到函数定义，尝试查找函数指针
+        real_func = index['functions'].get(real_func_name) or index['function_pointers'].get(real_func_name)
+        if real_func:
+            return (real_func_name, real_func, True)
     
-    # 查找函数指针定义
-    for func_ptr in data.get('function_pointers', []):
-        if func_ptr['name'] == func_name:
-            return (func_name, func_ptr, False)
+    # 如果不是宏定义，直接查找函数定义，然后查找函数指针定义
+    real_func = index['functions'].get(func_name) or index['function_pointers'].get(func_name)
+    if real_func:
+        return (func_name, real_func, False)
     
     return (None, None, False)
 
-def generate_binding_function(func, typedefs_data, export_functions):
-    """生成绑定函数实现（完整支持字符串/对象/数值参数）"""
+def generate_binding_function(func, typedefs_data, export_functions, storage='static ', name_suffix=''):
+    """生成绑定函数实现（完整支持字符串/对象/数值参数），name_suffix 用于生成被追踪包装的实现函数"""
     func_name = func['name']
     
     # 查找真实函数定义
@@ -537,30 +634,27 @@ def generate_binding_function(func, typedefs_data, export_functions):
     # 如果函数名在导出列表中，尝试强制查找宏定义
     if func_name in export_functions and not is_macro:
         # 查找是否有同名的宏定义
-        for macro in typedefs_data.get('macros', []):
-            if macro['name'] == func_name and 'initializer' in macro:
-                # 提取宏定义的底层函数名
-                real_func_name = macro['initializer'].strip()
-                if real_func_name.endswith(';'):
-                    real_func_name = real_func_name[:-1].strip()
-                
-                # 查找底层函数定义
-                for func_def in typedefs_data.get('functions', []):
-                    if func_def['name'] == real_func_name:
-                        real_func_def = func_def
-                        is_macro = True
-                        if print_all_info:
-                            print(f"{Fore.CYAN}[调试] 强制将 {func_name} 作为宏处理，底层实现为 {real_func_name}{Style.RESET_ALL}")
-                        break
-                else:
-                    # 查找函数指针定义
-                    for func_ptr in typedefs_data.get('function_pointers', []):
-                        if func_ptr['name'] == real_func_name:
-                            real_func_def = func_ptr
-                            is_macro = True
-                            if print_all_info:
-                                print(f"{Fore.CYAN}[调试] 强制将 {func_name} 作为宏处理，底层实现为函数指针 {real_func_name}{Style.RESET_ALL}")
-                            break
+        index = get_lvgl_index(typedefs_data)
+        for initializer in index['macro_initializers'].get(func_name, []):
+            # 提取宏定义的底层函数名
+            real_func_name = initializer.strip()
+            if real_func_name.endswith(';'):
+                real_func_name = real_func_name[:-1].strip()
+            
+            # 查找底层函数定义
+            if real_func_name in index['functions']:
+                real_func_def = index['functions'][real_func_name]
+                is_macro = True
+                if print_all_info:
+                    print(f"{Fore.CYAN}[调试] 强制将 {func_name} 作为宏处理，底层实现为 {real_func_name}{Style.RESET_ALL}")
+                break
+            # 查找函数指针定义
+            if real_func_name in index['function_pointers']:
+                real_func_def = index['function_pointers'][real_func_name]
+                is_macro = True
+                if print_all_info:
+                    print(f"{Fore.CYAN}[调试] 强制将 {func_name} 作为宏处理，底层实现为函数指针 {real_func_name}{Style.RESET_ALL}")
+                break
     
     if not real_func_def:
         print(f"{Fore.RED}[错误] 未找到函数 {func_name} 的定义，无法生成绑定{Style.RESET_ALL}")
@@ -584,7 +678,7 @@ def generate_binding_function(func, typedefs_data, export_functions):
 /**
  * @brief {docstring}
  */
-static jerry_value_t js_{func_name}(const jerry_call_info_t* call_info_p,
+{storage}jerry_value_t js_{func_name}{name_suffix}(const jerry_call_info_t* call_info_p,
     const jerry_value_t args[],
     const jerry_length_t argc) {{
 """
@@ -713,6 +807,53 @@ static jerry_value_t js_{func_name}(const jerry_call_info_t* call_info_p,
     
     return code
 
+def generate_trace_wrapper(func_name, trace_index):
+    """生成带进入/离开探针的包装函数，实际实现为 js_<name>_impl"""
+    trace_id = f"{TRACE_ID_BASE_MACRO} + {trace_index}"
+    return f"""
+jerry_value_t js_{func_name}(const jerry_call_info_t* call_info_p,
+    const jerry_value_t args[],
+    const jerry_length_t argc) {{
+    lv_binding_trace_begin({trace_id}, 0);
+    jerry_value_t ret = js_{func_name}_impl(call_info_p, args, argc);
+    lv_binding_trace_end({trace_id});
+    return ret;
+}}
+"""
+
+def generate_trace_names(functions):
+    """生成追踪编号到绑定名称的映射表"""
+    entries = ',\n'.join(f'    "{func["name"]}"' for func in functions)
+    return f"""
+static const char* const lvgl_binding_trace_names[] = {{
+{entries}
+}};
+"""
+
+def get_binding_family(func_name):
+    """获取函数所属的控件族，例如 lv_label_set_text -> label"""
+    parts = func_name.split('_')
+    if len(parts) >= 3 and parts[0] == 'lv' and parts[1]:
+        return parts[1]
+    return 'core'
+
+def normalize_generated_code(code):
+    """去掉生成日期，用于比较生成内容是否变化"""
+    return re.sub(r'^ \* @date .*$', '', code, flags=re.MULTILINE)
+
+def write_if_changed(file_path, content):
+    """仅在内容变化时写入文件，保持未变化文件的时间戳以支持增量编译"""
+    if os.path.exists(file_path):
+        with open(file_path, 'r', encoding='utf-8') as f:
+            if normalize_generated_code(f.read()) == normalize_generated_code(content):
+                if print_all_info:
+                    print(f"{Fore.BLUE}[跳过] 内容未变化: {file_path}{Style.RESET_ALL}")
+                return False
+    with open(file_path, 'w', encoding='utf-8') as f:
+        f.write(content)
+    print(f"{Fore.GREEN}[写入] {file_path}{Style.RESET_ALL}")
+    return True
+
 def generate_native_funcs_list(functions):
     """生成原生函数列表数组"""
     entries = []
@@ -730,6 +871,32 @@ const LVBindingJerryscriptFuncEntry_t lvgl_binding_funcs[] = {{
 const unsigned int lvgl_binding_funcs_count = {len(functions)+2};
 """
 
+class PatternSet(list):
+    """通配符模式列表，首次匹配时把所有模式编译为一个集合和一个正则表达式"""
+
+    def __init__(self, patterns=()):
+        super().__init__(patterns)
+        self._exact = None
+        self._regex = None
+
+    def _compile(self):
+        self._exact = set()
+        wildcards = []
+        for pattern in self:
+            if any(ch in pattern for ch in '*?['):
+                wildcards.append(fnmatch.translate(pattern))
+            else:
+                self._exact.add(pattern)
+        if wildcards:
+            self._regex = re.compile('|'.join(f"(?:{w})" for w in wildcards))
+
+    def matches(self, name):
+        if self._exact is None:
+            self._compile()
+        if name in self._exact:
+            return True
+        return bool(self._regex and self._regex.match(name))
+
 def load_export_macros(file_path):
     """从文件加载宏导出列表"""
     patterns = []
@@ -742,7 +909,7 @@ def load_export_macros(file_path):
         print(f"{Fore.GREEN}[加载] 从 {file_path} 读取了 {len(patterns)} 个导出宏模式{Style.RESET_ALL}")
     else:
         print(f"{Fore.YELLOW}[提示] 未找到宏导出列表文件: {file_path}{Style.RESET_ALL}")
-    return patterns
+    return PatternSet(patterns)
 
 def load_blacklist_macros(file_path):
     """从文件加载宏黑名单"""
@@ -756,7 +923,7 @@ def load_blacklist_macros(file_path):
         print(f"{Fore.GREEN}[加载] 从 {file_path} 读取了 {len(patterns)} 个黑名单宏模式{Style.RESET_ALL}")
     else:
         print(f"{Fore.YELLOW}[提示] 未找到宏黑名单文件: {file_path}{Style.RESET_ALL}")
-    return patterns
+    return PatternSet(patterns)
 
 def load_export_functions(file_path):
     """加载导出函数列表（支持通配符）"""
@@ -770,7 +937,7 @@ def load_export_functions(file_path):
         print(f"{Fore.GREEN}[加载] 从 {file_path} 读取了 {len(patterns)} 个导出函数模式{Style.RESET_ALL}")
     else:
         print(f"{Fore.YELLOW}[警告] 未找到函数导出列表文件: {file_path}{Style.RESET_ALL}")
-    return patterns
+    return PatternSet(patterns)
 
 def load_blacklist_functions(file_path):
     """加载黑名单函数列表（支持通配符）"""
@@ -784,10 +951,12 @@ def load_blacklist_functions(file_path):
         print(f"{Fore.GREEN}[加载] 从 {file_path} 读取了 {len(patterns)} 个黑名单函数模式{Style.RESET_ALL}")
     else:
         print(f"{Fore.YELLOW}[提示] 未找到黑名单函数列表文件: {file_path}{Style.RESET_ALL}")
-    return patterns
+    return PatternSet(patterns)
 
 def is_function_matched(func_name, patterns):
     """检查函数名是否匹配任意模式"""
+    if isinstance(patterns, PatternSet):
+        return patterns.matches(func_name)
     for pattern in patterns:
         if fnmatch.fnmatchcase(func_name, pattern):
             return True
@@ -836,8 +1005,184 @@ def extract_lvgl_functions_from_file(file_path):
         print(f"{Fore.RED}[错误] 处理文件 {file_path} 时出错: {str(e)}{Style.RESET_ALL}")
         return lvgl_functions
 
-def generate_enum_binding(enums, macros=None, export_macros=None, blacklist_macros=None):
-    """生成枚举绑定代码，处理enums和macros，直接注册到全局作用域"""
+def load_misc_binding_names(file_path):
+    """读取 lv_bindings_misc.c 中以 {"name", handler} 形式注册的函数名"""
+    if not os.path.exists(file_path):
+        return set()
+    with open(file_path, 'r', encoding='utf-8-sig') as f:
+        return set(re.findall(r'\{\s*"(\w+)"\s*,\s*\w+\s*\}', f.read()))
+
+def scan_app_references(app_dir, data):
+    """扫描整个应用目录的脚本，解析其引用的 LVGL 函数、LV_* 常量和 lv_font 成员"""
+    refs = {'functions': set(), 'constants': set(), 'fonts': set(), 'all_fonts': False}
+    identifiers = set()
+    warning_functions = {
+        'lv_obj_add_event_cb',
+    }
+    scanned = 0
+
+    for root, dirs, files in os.walk(app_dir):
+        dirs.sort()
+        for file_name in sorted(files):
+            if not file_name.endswith(('.js', '.mjs')):
+                continue
+            file_path = os.path.join(root, file_name)
+            try:
+                with open(file_path, 'r', encoding='utf-8') as f:
+                    content = f.read()
+            except Exception as e:
+                print(f"{Fore.RED}[错误] 处理文件 {file_path} 时出错: {str(e)}{Style.RESET_ALL}")
+                continue
+            scanned += 1
+
+            identifiers.update(re.findall(r'\b(?:lv|LV)_\w+', content))
+            refs['fonts'].update(re.findall(r'\blv_font\s*\.\s*(\w+)', content))
+            refs['fonts'].update(re.findall(r'\blv_font\s*\[\s*[\'"](\w+)[\'"]\s*\]', content))
+            # 动态访问无法静态解析，保守地保留全部字体
+            if re.search(r'\blv_font\s*\[\s*[^\'"\s]', content):
+                print(f"{Fore.YELLOW}[警告] {file_path} 动态访问 lv_font，保留全部字体{Style.RESET_ALL}")
+                refs['all_fonts'] = True
+            if re.search(r'\b(?:globalThis|this)\s*\[', content):
+                print(f"{Fore.YELLOW}[警告] {file_path} 存在动态全局访问，可能引用未被保留的绑定{Style.RESET_ALL}")
+
+    misc_names = load_misc_binding_names(misc_bindings_file)
+    for name in identifiers:
+        if name.startswith('LV_'):
+            refs['constants'].add(name)
+        elif name in misc_names:
+            continue
+        elif find_real_function_definition(name, data)[1]:
+            refs['functions'].add(name)
+            if name in warning_functions:
+                print(f"{Fore.RED}[安全警告] 检测到潜在风险函数调用: {name}{Style.RESET_ALL}")
+
+    print(f"{Fore.GREEN}[摇树] 扫描 {scanned} 个脚本: {len(refs['functions'])} 个函数, "
+          f"{len(refs['constants'])} 个常量, {len(refs['fonts'])} 个字体{Style.RESET_ALL}")
+    return refs
+
+def generate_gen_conf_header(app_refs):
+    """生成 lv_bindings_gen_conf.h，摇树模式下只启用被引用的字体"""
+    lines = [
+        "/**",
+        f" * @file {GEN_CONF_FILE}",
+        " * @brief LVGL 绑定生成配置，此文件使用脚本自动生成。",
+        " * @author Sab1e",
+        " */",
+        "#ifndef LV_BINDINGS_GEN_CONF_H",
+        "#define LV_BINDINGS_GEN_CONF_H",
+        "",
+    ]
+    if trace_bindings:
+        lines.append("#define LV_BINDING_TRACE 1")
+    if app_refs is None or app_refs['all_fonts']:
+        lines.append("#define LV_BINDING_FONT_FILTER 0")
+    else:
+        lines.append("#define LV_BINDING_FONT_FILTER 1")
+        for size in MONTSERRAT_FONT_SIZES:
+            if f"lv_font_montserrat_{size}" in app_refs['fonts']:
+                lines.append(f"#define LV_BINDING_USE_FONT_MONTSERRAT_{size} 1")
+        for font in sorted(app_refs['fonts']):
+            if not re.fullmatch(r'lv_font_montserrat_\d+', font):
+                print(f"{Fore.YELLOW}[警告] 未知的字体 lv_font.{font}{Style.RESET_ALL}")
+    lines.append("")
+    lines.append("#endif // LV_BINDINGS_GEN_CONF_H")
+    return "\n".join(lines) + "\n"
+
+def count_enum_registrations(enum_binding):
+    """统计枚举绑定代码在启动时设置的全局属性数量"""
+    return enum_binding.count('lvgl_binding_set_enum(global') + enum_binding.count('jerry_object_set(global')
+
+def generate_binding_sources_size(funcs, data, export_patterns):
+    """静默生成绑定函数并返回源码字节数"""
+    with contextlib.redirect_stdout(io.StringIO()):
+        return sum(len(generate_binding_function(func, data, export_patterns, storage='').encode('utf-8'))
+                   for func in funcs)
+
+def generate_report_sources(funcs, data, export_patterns, enum_binding):
+    """静默生成一组完整的绑定源码（各绑定单元及 lv_bindings.c），用于编译测量目标文件体积"""
+    units = {}
+    for func in funcs:
+        units.setdefault(get_binding_family(func['name']), []).append(func)
+    sources = {}
+    with contextlib.redirect_stdout(io.StringIO()):
+        for family in sorted(units):
+            file_name = f"{UNIT_FILE_PREFIX}{family}.c"
+            binding_code = "".join(generate_binding_function(func, data, export_patterns, storage='') + "\n\n"
+                                   for func in units[family])
+            unit_header = UNIT_HEADER_CODE.format(file_name=file_name, family=family)
+            if 'throw_error(' in binding_code:
+                unit_header += UNIT_THROW_ERROR_CODE
+            sources[file_name] = unit_header + binding_code
+        func_decls = ''.join(
+            f"jerry_value_t js_{func['name']}(const jerry_call_info_t*, const jerry_value_t*, jerry_length_t);\n"
+            for func in funcs)
+        sources['lv_bindings.c'] = (HEADER_CODE + func_decls + "\n" + generate_native_funcs_list(funcs) + "\n" +
+                                    enum_binding + "\n" + INIT_FUNCTION_CODE)
+    return sources
+
+def measure_object_size(sources, work_dir):
+    """编译源码并用 size 统计目标文件的 text/data/bss 字节数，缺少工具或编译失败时返回 None"""
+    cc = shlex.split(os.environ.get('CC', 'cc'))
+    size_tool = os.environ.get('SIZE', 'size')
+    if not cc or not shutil.which(cc[0]) or not shutil.which(size_tool):
+        print(f"{Fore.YELLOW}[摇树报告] 未找到编译器或 size 工具，跳过目标文件体积统计{Style.RESET_ALL}")
+        return None
+    include_dirs = ['-I' + os.path.join(script_dir, 'inc'), '-I' + os.path.join(script_dir, 'src')]
+    totals = {'text': 0, 'data': 0, 'bss': 0}
+    for file_name, code in sources.items():
+        source_path = os.path.join(work_dir, file_name)
+        object_path = source_path[:-2] + '.o'
+        with open(source_path, 'w', encoding='utf-8') as f:
+            f.write(code)
+        result = subprocess.run(cc + ['-c', '-Os'] + include_dirs + shlex.split(shake_cflags) +
+                                [source_path, '-o', object_path], capture_output=True, text=True)
+        if result.returncode != 0:
+            print(f"{Fore.YELLOW}[摇树报告] 编译 {file_name} 失败，跳过目标文件体积统计"
+                  f"（可用 --shake-cflags= 指定头文件路径）:\n{result.stderr.strip()[-2000:]}{Style.RESET_ALL}")
+            return None
+        result = subprocess.run([size_tool, object_path], capture_output=True, text=True)
+        fields = result.stdout.splitlines()[-1].split() if result.returncode == 0 and result.stdout else []
+        if len(fields) < 3:
+            print(f"{Fore.YELLOW}[摇树报告] 无法解析 {size_tool} 的输出，跳过目标文件体积统计{Style.RESET_ALL}")
+            return None
+        for key, value in zip(('text', 'data', 'bss'), fields[:3]):
+            totals[key] += int(value)
+    return totals
+
+def load_bench_binding_init(bench_path):
+    """从 bench/lv_bindings_bench.c 输出的 JSON 中读取 lv_binding_init 的耗时与堆占用"""
+    try:
+        with open(bench_path, 'r', encoding='utf-8') as f:
+            binding_init = json.load(f)['binding_init']
+        return {
+            'binding_init_us': binding_init['time_us'],
+            'binding_init_jerry_heap_bytes': binding_init['jerry_heap_bytes'],
+            'binding_init_lvgl_heap_bytes': binding_init['lvgl_heap_bytes'],
+        }
+    except (OSError, ValueError, KeyError, TypeError) as e:
+        print(f"{Fore.YELLOW}[摇树报告] 无法读取基准测试结果 {bench_path}: {e}{Style.RESET_ALL}")
+        return {}
+
+def write_shake_report(report_path, full, shaken):
+    """输出摇树前后的对比报告（JSON）并打印摘要"""
+    report = {'app_dir': shake_app_dir, 'full': full, 'shaken': shaken, 'saved': {}}
+    print(f"\n{Fore.CYAN}[摇树报告] {shake_app_dir}{Style.RESET_ALL}")
+    for key in full:
+        if key not in shaken:
+            continue
+        saved = full[key] - shaken[key]
+        report['saved'][key] = saved
+        percent = (saved * 100.0 / full[key]) if full[key] else 0.0
+        print(f"  {key:<30} {full[key]:>10} -> {shaken[key]:>10}  (-{saved:g}, {percent:.1f}%)")
+    # object_* 为 -Os 编译后的目标文件段大小（不含链接时的裁剪）；binding_init_* 仅在
+    # 通过 --shake-bench= 提供两份基准测试结果时出现，其余字段为生成代码的计数
+    with open(report_path, 'w', encoding='utf-8') as f:
+        json.dump(report, f, indent=2, ensure_ascii=False)
+    print(f"{Fore.GREEN}[摇树报告] 已写入: {report_path}{Style.RESET_ALL}")
+
+def generate_enum_binding(enums, macros=None, export_macros=None, blacklist_macros=None, used_names=None):
+    """生成枚举绑定代码，处理enums和macros，直接注册到全局作用域；
+    指定 used_names 时只注册其中出现的常量"""
     lines = []
     lines.append("static void register_lvgl_enums(void) {")
     lines.append("    jerry_value_t global = jerry_current_realm();")
@@ -851,6 +1196,8 @@ def generate_enum_binding(enums, macros=None, export_macros=None, blacklist_macr
                 continue
             name = member.get('name')
             value = member.get('value')
+            if used_names is not None and name not in used_names:
+                continue
             if name and value is not None:
                 try:
                     if isinstance(value, str):
@@ -878,6 +1225,10 @@ def generate_enum_binding(enums, macros=None, export_macros=None, blacklist_macr
             if not macro_name:
                 continue
                 
+            # 摇树模式下跳过未被引用的宏
+            if used_names is not None and macro_name not in used_names:
+                continue
+
             # 跳过带参数的宏
             if macro.get('params'):
                 if print_macro_info:
@@ -913,48 +1264,12 @@ def generate_enum_binding(enums, macros=None, export_macros=None, blacklist_macr
     lines.append("}")
     return "\n".join(lines)
 
-def main():
-    # 如果指定了--extract-funcs-from参数，先执行提取功能
-    if extract_funcs_from:
-        extracted_funcs = extract_lvgl_functions_from_file(extract_funcs_from)
-        if extracted_funcs:
-            # 加载现有的导出函数列表
-            existing_funcs = set()
-            if os.path.exists(export_functions_path):
-                with open(export_functions_path, 'r', encoding='utf-8') as f:
-                    existing_funcs = {line.strip() for line in f if line.strip() and not line.startswith('#')}
-
-            # 找出需要添加的新函数
-            new_funcs = extracted_funcs - existing_funcs
-
-            if new_funcs:
-                # 追加新函数到文件
-                with open(export_functions_path, 'a', encoding='utf-8') as f:
-                    for func in sorted(new_funcs):
-                        f.write(f"{func}\n")
-                print(f"{Fore.GREEN}[更新完成] 向 {export_functions_path} 中添加了 {len(new_funcs)} 个新函数{Style.RESET_ALL}")
-            else:
-                print(f"{Fore.GREEN}[无需更新] 没有发现新的lvgl函数需要添加{Style.RESET_ALL}")
-
-    # 从同级目录读取lvgl.json
-    if not os.path.exists(input_json_file):
-        print(f"{Fore.RED}[错误] 找不到输入文件: {input_json_file}{Style.RESET_ALL}")
-        return
-    
-    with open(input_json_file, 'r') as f:
-        data = json.load(f)
-    
-    # 生成绑定函数
-    binding_code = ""
-    EXPORT_FUNCTION_PATTERNS = load_export_functions(export_functions_path)
-    BLACKLIST_FUNCTION_PATTERNS = load_blacklist_functions(blacklist_functions_path)
-    EXPORT_MACROS = load_export_macros(export_macros_path)
-    BLACKLIST_MACROS = load_blacklist_macros(blacklist_macros_path)
-    
+def select_exported_functions(data, export_patterns, blacklist_patterns, verbose=True):
+    """选出匹配白名单且不在黑名单中的函数，返回 (导出函数列表, 未找到的导出项)"""
     # 收集所有需要导出的函数（匹配白名单且不在黑名单中的函数）
     exported_funcs = []
     matched_funcs = set()
-    missing_funcs = set(EXPORT_FUNCTION_PATTERNS)  # 初始化包含所有导出模式
+    missing_funcs = set(export_patterns)  # 初始化包含所有导出模式
     
     # 1. 首先处理所有函数
     for func in data.get('functions', []):
@@ -963,12 +1278,13 @@ def main():
             continue
             
         # 检查是否在导出模式中
-        if not is_function_matched(func_name, EXPORT_FUNCTION_PATTERNS):
+        if not is_function_matched(func_name, export_patterns):
             continue
             
         # 检查是否在黑名单中
-        if is_function_matched(func_name, BLACKLIST_FUNCTION_PATTERNS):
-            print(f"{Fore.RED}[黑名单] 跳过函数 {func_name}{Style.RESET_ALL}")
+        if is_function_matched(func_name, blacklist_patterns):
+            if verbose:
+                print(f"{Fore.RED}[黑名单] 跳过函数 {func_name}{Style.RESET_ALL}")
             missing_funcs.discard(func_name)
             continue
             
@@ -983,12 +1299,13 @@ def main():
             continue
             
         # 检查是否在导出模式中
-        if not is_function_matched(macro_name, EXPORT_FUNCTION_PATTERNS):
+        if not is_function_matched(macro_name, export_patterns):
             continue
             
         # 检查是否在黑名单中
-        if is_function_matched(macro_name, BLACKLIST_FUNCTION_PATTERNS):
-            print(f"{Fore.RED}[黑名单] 跳过宏 {macro_name}{Style.RESET_ALL}")
+        if is_function_matched(macro_name, blacklist_patterns):
+            if verbose:
+                print(f"{Fore.RED}[黑名单] 跳过宏 {macro_name}{Style.RESET_ALL}")
             missing_funcs.discard(macro_name)
             continue
             
@@ -1005,9 +1322,60 @@ def main():
             matched_funcs.add(macro_name)
             missing_funcs.discard(macro_name)
         else:
-            print(f"{Fore.YELLOW}[警告] 宏 {macro_name} 没有initializer，无法作为函数处理{Style.RESET_ALL}")
+            if verbose:
+                print(f"{Fore.YELLOW}[警告] 宏 {macro_name} 没有initializer，无法作为函数处理{Style.RESET_ALL}")
             missing_funcs.discard(macro_name)
 
+    return exported_funcs, missing_funcs
+
+def main():
+    # 如果指定了--extract-funcs-from参数，先执行提取功能
+    if extract_funcs_from:
+        extracted_funcs = extract_lvgl_functions_from_file(extract_funcs_from)
+        if extracted_funcs:
+            # 加载现有的导出函数列表
+            existing_funcs = set()
+            if os.path.exists(export_functions_path):
+                with open(export_functions_path, 'r', encoding='utf-8') as f:
+                    existing_funcs = {line.strip() for line in f if line.strip() and not line.startswith('#')}
+
+            # 找出需要添加的新函数
+            new_funcs = extracted_funcs - existing_funcs
+
+            if new_funcs:
+                # 追加新函数到文件
+                with open(export_functions_path, 'a', encoding='utf-8') as f:
+                    for func in sorted(new_funcs):
+                        f.write(f"{func}\n")
+                print(f"{Fore.GREEN}[更新完成] 向 {export_functions_path} 中添加了 {len(new_funcs)} 个新函数{Style.RESET_ALL}")
+            else:
+                print(f"{Fore.GREEN}[无需更新] 没有发现新的lvgl函数需要添加{Style.RESET_ALL}")
+
+    # 从同级目录读取lvgl.json
+    if not os.path.exists(input_json_file):
+        print(f"{Fore.RED}[错误] 找不到输入文件: {input_json_file}{Style.RESET_ALL}")
+        return
+    
+    data = load_lvgl_json(input_json_file)
+    
+    EXPORT_FUNCTION_PATTERNS = load_export_functions(export_functions_path)
+    BLACKLIST_FUNCTION_PATTERNS = load_blacklist_functions(blacklist_functions_path)
+    EXPORT_MACROS = load_export_macros(export_macros_path)
+    BLACKLIST_MACROS = load_blacklist_macros(blacklist_macros_path)
+    
+    # 整个应用目录的摇树模式：只导出脚本实际引用的函数、常量和字体
+    app_refs = None
+    if shake_app_dir:
+        app_refs = scan_app_references(shake_app_dir, data)
+        full_export_patterns = EXPORT_FUNCTION_PATTERNS
+        # 只在导出列表范围内摇树，脚本引用了但未列入 export_functions.txt 的函数不导出
+        unlisted_funcs = sorted(name for name in app_refs['functions'] if not is_function_matched(name, full_export_patterns))
+        for name in unlisted_funcs:
+            print(f"{Fore.YELLOW}[警告] 脚本引用的 {name} 不在 export_functions.txt 中，不会导出{Style.RESET_ALL}")
+        EXPORT_FUNCTION_PATTERNS = PatternSet(sorted(app_refs['functions'].difference(unlisted_funcs)))
+    
+    exported_funcs, missing_funcs = select_exported_functions(data, EXPORT_FUNCTION_PATTERNS, BLACKLIST_FUNCTION_PATTERNS)
+
     # 打印未生成的函数
     if missing_funcs:
         print(f"\n{Fore.YELLOW}[警告] 以下函数在export_functions.txt中指定但未生成:{Style.RESET_ALL}")
@@ -1018,16 +1386,52 @@ def main():
         print(f"{Fore.RED}[错误] 没有找到匹配的导出函数，请检查 export_functions.txt 文件。匹配模式: {EXPORT_FUNCTION_PATTERNS}{Style.RESET_ALL}")
         return
     
-    # 生成函数声明
+    # 生成函数声明（实现位于各控件族的绑定单元中）
     func_decls = ''.join([
-        f"static jerry_value_t js_{func['name']}(const jerry_call_info_t*, const jerry_value_t*, jerry_length_t);\n"
+        f"jerry_value_t js_{func['name']}(const jerry_call_info_t*, const jerry_value_t*, jerry_length_t);\n"
         for func in exported_funcs
     ])
     
-    # 生成函数实现
+    # 按控件族生成绑定单元
+    units = {}
     for func in exported_funcs:
-        binding_code += generate_binding_function(func, data, EXPORT_FUNCTION_PATTERNS)
-        binding_code += "\n\n"
+        units.setdefault(get_binding_family(func['name']), []).append(func)
+    
+    output_dir = os.path.dirname(output_c_file)
+    os.makedirs(output_dir, exist_ok=True)
+    unit_files = set()
+    trace_ids = {func['name']: i for i, func in enumerate(exported_funcs)}
+    for family in sorted(units):
+        file_name = f"{UNIT_FILE_PREFIX}{family}.c"
+        unit_files.add(file_name)
+        binding_code = ""
+        for func in units[family]:
+            if trace_bindings:
+                impl_code = generate_binding_function(func, data, EXPORT_FUNCTION_PATTERNS, name_suffix='_impl')
+                if impl_code:
+                    impl_code += generate_trace_wrapper(func['name'], trace_ids[func['name']])
+                binding_code += impl_code
+            else:
+                binding_code += generate_binding_function(func, data, EXPORT_FUNCTION_PATTERNS, storage='')
+            binding_code += "\n\n"
+        unit_header = UNIT_HEADER_CODE.format(file_name=file_name, family=family)
+        if trace_bindings:
+            unit_header = unit_header.replace('#include "lv_bindings_misc.h"\n',
+                                              '#include "lv_bindings_misc.h"\n#include "lv_bindings_trace.h"\n')
+        if 'throw_error(' in binding_code:
+            unit_header += UNIT_THROW_ERROR_CODE
+        unit_output = (
+            unit_header +
+            "// 函数实现\n" +
+            binding_code
+        )
+        write_if_changed(os.path.join(output_dir, file_name), unit_output)
+    
+    # 删除已不再需要的绑定单元
+    for name in sorted(os.listdir(output_dir)):
+        if name.startswith(UNIT_FILE_PREFIX) and name.endswith('.c') and name not in unit_files:
+            os.remove(os.path.join(output_dir, name))
+            print(f"{Fore.YELLOW}[删除] 移除过期的绑定单元: {name}{Style.RESET_ALL}")
     
     # 生成函数列表
     func_list = generate_native_funcs_list(exported_funcs)
@@ -1041,26 +1445,75 @@ def main():
         enums,
         macros,
         EXPORT_MACROS,
-        BLACKLIST_MACROS
+        BLACKLIST_MACROS,
+        app_refs['constants'] if app_refs else None
     )
     
+    # 生成编译配置头文件
+    write_if_changed(os.path.join(gen_conf_dir, GEN_CONF_FILE), generate_gen_conf_header(app_refs))
+    # 旧版本写在输出目录中的配置会被同目录的源文件优先包含，需删除
+    stale_conf = os.path.join(output_dir, GEN_CONF_FILE)
+    if os.path.abspath(output_dir) != os.path.abspath(gen_conf_dir) and os.path.exists(stale_conf):
+        os.remove(stale_conf)
+        print(f"{Fore.YELLOW}[删除] 移除过期的配置头文件: {stale_conf}{Style.RESET_ALL}")
+    
     # 构建完整的C代码
+    header_code = HEADER_CODE
+    init_code = INIT_FUNCTION_CODE
+    if trace_bindings:
+        header_code = header_code.replace('#include "lv_bindings_misc.h"\n',
+                                          '#include "lv_bindings_misc.h"\n#include "lv_bindings_trace.h"\n')
+        func_list += generate_trace_names(exported_funcs)
+        init_code = init_code.replace('    lv_bindings_misc_init();\n',
+                                      '    lv_binding_trace_register_names(lvgl_binding_trace_names, '
+                                      f'{len(exported_funcs)});\n    lv_bindings_misc_init();\n')
     output = (
-        HEADER_CODE +
+        header_code +
         "// 函数声明\n" +
         func_decls + "\n" +
-        "// 函数实现\n" +
-        binding_code +
         func_list + "\n" +
         enum_binding + "\n" +
-        INIT_FUNCTION_CODE
+        init_code
     )
     
     # 输出到.c文件
-    os.makedirs(os.path.dirname(output_c_file), exist_ok=True)
-    with open(output_c_file, "w", encoding="utf-8") as f:
-        f.write(output)
-    print(f"{Fore.GREEN}✅ 生成C代码已写入: {output_c_file}{Style.RESET_ALL}")
+    write_if_changed(output_c_file, output)
+    print(f"{Fore.GREEN}✅ 生成C代码已写入: {output_dir}（{len(units)} 个绑定单元）{Style.RESET_ALL}")
+    
+    # 摇树报告：与按导出列表完整生成的结果对比
+    if app_refs:
+        full_funcs, _ = select_exported_functions(data, full_export_patterns, BLACKLIST_FUNCTION_PATTERNS, verbose=False)
+        full_enum_binding = generate_enum_binding(enums, macros, EXPORT_MACROS, BLACKLIST_MACROS)
+        shaken_fonts = len(MONTSERRAT_FONT_SIZES) if app_refs['all_fonts'] else len(
+            [size for size in MONTSERRAT_FONT_SIZES if f"lv_font_montserrat_{size}" in app_refs['fonts']])
+        full = {
+            'functions': len(full_funcs),
+            'generated_source_bytes': generate_binding_sources_size(full_funcs, data, full_export_patterns),
+            'enum_registrations': count_enum_registrations(full_enum_binding),
+            'fonts': len(MONTSERRAT_FONT_SIZES),
+        }
+        shaken = {
+            'functions': len(exported_funcs),
+            'generated_source_bytes': generate_binding_sources_size(exported_funcs, data, EXPORT_FUNCTION_PATTERNS),
+            'enum_registrations': count_enum_registrations(enum_binding),
+            'fonts': shaken_fonts,
+        }
+        full['global_registrations'] = full['functions'] + full['enum_registrations'] + full['fonts']
+        shaken['global_registrations'] = shaken['functions'] + shaken['enum_registrations'] + shaken['fonts']
+        with tempfile.TemporaryDirectory() as work_dir:
+            full_size = measure_object_size(
+                generate_report_sources(full_funcs, data, full_export_patterns, full_enum_binding), work_dir)
+            shaken_size = measure_object_size(
+                generate_report_sources(exported_funcs, data, EXPORT_FUNCTION_PATTERNS, enum_binding),
+                work_dir) if full_size else None
+        if full_size and shaken_size:
+            for key in ('text', 'data', 'bss'):
+                full[f'object_{key}_bytes'] = full_size[key]
+                shaken[f'object_{key}_bytes'] = shaken_size[key]
+        if shake_bench_files:
+            full.update(load_bench_binding_init(shake_bench_files[0]))
+            shaken.update(load_bench_binding_init(shake_bench_files[1]))
+        write_shake_report(os.path.join(output_dir, 'lv_bindings_shake_report.json'), full, shaken)
 
 if __name__ == "__main__":
     for arg in sys.argv:
@@ -1073,6 +1526,19 @@ if __name__ == "__main__":
         elif arg.startswith('--output-c-path='):
             output_c_file = arg.split('=', 1)[1]
             output_c_file = output_c_file+"./lv_bindings.c"
+        elif arg == '--no-json-cache':
+            use_json_cache = False
+        elif arg.startswith('--shake-app='):
+            shake_app_dir = arg.split('=', 1)[1]
+        elif arg.startswith('--shake-cflags='):
+            shake_cflags = arg.split('=', 1)[1]
+        elif arg.startswith('--shake-bench='):
+            shake_bench_files = arg.split('=', 1)[1].split(',')
+            if len(shake_bench_files) != 2:
+                print(f"{Fore.RED}[错误] --shake-bench= 需要两个以逗号分隔的文件：<完整生成>,<摇树生成>{Style.RESET_ALL}")
+                exit()
+        elif arg == '--trace':
+            trace_bindings = True
         elif arg.startswith('--extract-funcs-from='):
             extract_funcs_from = arg.split('=', 1)[1]
         elif arg.startswith('--cfg-path='):
@@ -21,6 +21,9 @@ typedef struct {
     const char* name;
     jerry_external_handler_t handler;
 } LVBindingJerryscriptFuncEntry_t;
+
+// 绑定上下文，每个应用（或 realm）一个，拥有该应用注册的回调、定时器和样式
+typedef struct LVBindingContext LVBindingContext_t;
 // 函数声明
 void lv_bindings_misc_init();
 lv_color_t js_to_lv_color(jerry_value_t js_color);
@@ -28,6 +31,11 @@ jerry_value_t lv_color_to_js(lv_color_t color);
 
 void lv_binding_jerryscript_register_functions(const LVBindingJerryscriptFuncEntry_t* entry,const size_t funcs_count);
 
+LVBindingContext_t* lv_binding_ctx_create(void);
+void lv_binding_ctx_destroy(LVBindingContext_t* ctx);
+LVBindingContext_t* lv_binding_ctx_set_current(LVBindingContext_t* ctx);
+LVBindingContext_t* lv_binding_ctx_get_current(void);
+
 #ifdef __cplusplus
 }
 #endif
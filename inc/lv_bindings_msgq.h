@@ -0,0 +1,60 @@
+﻿
+/**
+ * @lv_bindings_msgq.h
+ * @brief 跨线程消息队列头文件（多生产者单消费者，无锁）
+ * @author Sab1e
+ * @date 2026-10-18
+ */
+#ifndef LV_BINDINGS_MSGQ_H
+#define LV_BINDINGS_MSGQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+// 配置
+#ifndef LV_BINDING_MSGQ_CAPACITY
+#define LV_BINDING_MSGQ_CAPACITY 256 // 队列容量，必须为 2 的幂
+#endif
+#ifndef LV_BINDING_MSGQ_PAYLOAD_SIZE
+#define LV_BINDING_MSGQ_PAYLOAD_SIZE 32 // 字节消息的最大长度
+#endif
+#ifndef LV_BINDING_MSGQ_DEFAULT_BUDGET
+#define LV_BINDING_MSGQ_DEFAULT_BUDGET 32 // UI 线程每次最多处理的消息数
+#endif
+#ifndef LV_BINDING_MSGQ_PERIOD
+#define LV_BINDING_MSGQ_PERIOD 10 // UI 线程处理消息的 lv_timer 周期（毫秒）
+#endif
+// 类型声明
+typedef enum {
+    LV_BINDING_MSGQ_NUMBER = 0,
+    LV_BINDING_MSGQ_BYTES,
+} LVBindingMsgqType_t;
+
+typedef struct {
+    uint32_t topic;
+    uint8_t type; // LVBindingMsgqType_t
+    uint8_t len;  // 字节消息的长度
+    union {
+        double number;
+        uint8_t bytes[LV_BINDING_MSGQ_PAYLOAD_SIZE];
+    } data;
+} LVBindingMsgqMessage_t;
+
+typedef void (*LVBindingMsgqHandler_t)(const LVBindingMsgqMessage_t* msg, void* user_data);
+// 函数声明（post 系列可在任意线程调用，其余只能在 UI 线程调用）
+bool lv_binding_msgq_post_number(uint32_t topic, double value);
+bool lv_binding_msgq_post_bytes(uint32_t topic, const void* data, size_t len);
+uint32_t lv_binding_msgq_drain(LVBindingMsgqHandler_t handler, void* user_data, uint32_t max_count);
+void lv_binding_msgq_set_budget(uint32_t budget);
+uint32_t lv_binding_msgq_get_budget(void);
+uint32_t lv_binding_msgq_get_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LV_BINDINGS_MSGQ_H
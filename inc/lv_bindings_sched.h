@@ -0,0 +1,74 @@
+﻿
+/**
+ * @lv_bindings_sched.h
+ * @brief JS 调度头文件（按帧预算执行 Promise 任务、回调看门狗）
+ * @author Sab1e
+ * @date 2026-10-18
+ */
+#ifndef LV_BINDINGS_SCHED_H
+#define LV_BINDINGS_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+#include "jerryscript.h"
+// 配置
+#ifndef LV_BINDING_FRAME_PERIOD
+#define LV_BINDING_FRAME_PERIOD LV_DEF_REFR_PERIOD // 一帧的时长（毫秒），与 LVGL 刷新周期一致
+#endif
+#ifndef LV_BINDING_JOB_BUDGET
+#define LV_BINDING_JOB_BUDGET 8 // 每帧内 JS 最多占用的时间（毫秒），超出后 Promise 任务推迟到下一帧，0 表示不限制
+#endif
+// LV_BINDING_JOB_BUDGET 只决定本帧是否开始执行 Promise 任务：开始后 jerry_run_jobs() 会执行完
+// 整个队列（包括执行中新加入的任务），JerryScript 没有逐个执行任务的接口，在任务中途中止会使
+// 对应的 Promise 永远无法兑现，因此不在执行中途截断。单次执行仍受 LV_BINDING_WATCHDOG_LIMIT 约束
+#ifndef LV_BINDING_JOB_PERIOD
+#define LV_BINDING_JOB_PERIOD 5 // 执行 Promise 任务的 lv_timer 周期（毫秒）
+#endif
+#ifndef LV_BINDING_WATCHDOG_LIMIT
+#define LV_BINDING_WATCHDOG_LIMIT 200 // 单次回调的硬上限（毫秒），超出后中止执行，0 表示不限制
+#endif
+#ifndef LV_BINDING_WATCHDOG_INTERVAL
+#define LV_BINDING_WATCHDOG_INTERVAL 256 // 虚拟机每执行多少次检查点调用一次看门狗
+#endif
+// LV_BINDING_CLOCK_US()：返回微秒计数的表达式，用于统计每帧 JS 耗时。默认在 POSIX 上使用
+// CLOCK_MONOTONIC；其他平台退回到 lv_tick_get() * 1000，此时不足 1 毫秒的回调计为 0，
+// 帧预算只对毫秒级的回调生效，建议在 MCU 上定义为硬件计时器（如 DWT 周期计数换算）
+// 类型声明
+typedef enum {
+    LV_BINDING_CALL_EVENT = 0, // 事件回调
+    LV_BINDING_CALL_TIMER,     // 定时器回调
+    LV_BINDING_CALL_MSGQ,      // 跨线程消息处理函数
+    LV_BINDING_CALL_ANIM,      // 动画回调
+    LV_BINDING_CALL_JOBS,      // Promise 任务
+} LVBindingCallSource_t;
+
+typedef struct {
+    LVBindingCallSource_t source;
+    jerry_value_t callback; // 超时的 JS 函数（借用，执行 Promise 任务时为 undefined）
+    uint32_t elapsed_ms;
+    bool aborted; // 是否已被看门狗中止
+} LVBindingOverrunInfo_t;
+
+typedef void (*LVBindingOverrunCb_t)(const LVBindingOverrunInfo_t* info, void* user_data);
+// 函数声明
+void lv_binding_sched_init(void);
+uint32_t lv_binding_clock_us(void);
+jerry_value_t lv_binding_sched_call(LVBindingCallSource_t source, jerry_value_t func, jerry_value_t this_val,
+                                    const jerry_value_t args[], jerry_size_t argc);
+void lv_binding_set_job_budget(uint32_t budget_ms);
+uint32_t lv_binding_get_job_budget(void);
+void lv_binding_set_watchdog_limit(uint32_t limit_ms);
+uint32_t lv_binding_get_watchdog_limit(void);
+void lv_binding_set_overrun_cb(LVBindingOverrunCb_t cb, void* user_data);
+uint32_t lv_binding_get_overrun_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LV_BINDINGS_SCHED_H
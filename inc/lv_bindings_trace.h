@@ -0,0 +1,68 @@
+﻿
+/**
+ * @lv_bindings_trace.h
+ * @brief 绑定调用追踪头文件（无锁环形缓冲，导出 Chrome trace-event JSON）
+ * @author Sab1e
+ * @date 2026-10-18
+ */
+#ifndef LV_BINDINGS_TRACE_H
+#define LV_BINDINGS_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+// 由 gen_lvgl_binding.py --trace 生成的配置（与本文件同在 inc/ 目录）中定义 LV_BINDING_TRACE
+#if defined(__has_include)
+#if __has_include("lv_bindings_gen_conf.h")
+#include "lv_bindings_gen_conf.h"
+#endif
+#endif
+// 配置
+#ifndef LV_BINDING_TRACE
+#define LV_BINDING_TRACE 0
+#endif
+#ifndef LV_BINDING_TRACE_CAPACITY
+#define LV_BINDING_TRACE_CAPACITY 4096 // 环形缓冲的记录数，必须为 2 的幂，写满后覆盖最早的记录
+#endif
+#ifndef LV_BINDING_TRACE_USE_STDIO
+#define LV_BINDING_TRACE_USE_STDIO 1 // 提供写文件的 lv_binding_trace_dump
+#endif
+// 类型声明
+enum {
+    LV_BINDING_TRACE_ID_EVENT = 0, // lv_event_handler 分发，参数为事件码
+    LV_BINDING_TRACE_ID_TIMER,     // lv_timer_create 创建的定时器回调
+    LV_BINDING_TRACE_ID_MSGQ,      // 跨线程消息处理函数，参数为消息主题
+    LV_BINDING_TRACE_ID_ANIM,      // lv_anim_async 的动画回调
+    LV_BINDING_TRACE_ID_GENERATED = 16, // 生成的绑定按 lvgl_binding_funcs 中的顺序从这里开始编号
+};
+
+typedef void (*LVBindingTraceWriteCb_t)(const char* data, size_t len, void* user_data);
+
+#if LV_BINDING_TRACE
+// 函数声明
+void lv_binding_trace_begin(uint32_t id, int32_t arg);
+void lv_binding_trace_end(uint32_t id);
+void lv_binding_trace_register_names(const char* const* names, uint32_t count);
+void lv_binding_trace_set_enabled(bool enabled);
+void lv_binding_trace_clear(void);
+uint32_t lv_binding_trace_write(LVBindingTraceWriteCb_t write_cb, void* user_data);
+#if LV_BINDING_TRACE_USE_STDIO
+int32_t lv_binding_trace_dump(const char* path);
+#endif
+
+#define LV_BINDING_TRACE_BEGIN(id, arg) lv_binding_trace_begin((id), (arg))
+#define LV_BINDING_TRACE_END(id) lv_binding_trace_end(id)
+#else
+#define LV_BINDING_TRACE_BEGIN(id, arg) ((void)0)
+#define LV_BINDING_TRACE_END(id) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LV_BINDINGS_TRACE_H
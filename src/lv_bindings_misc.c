@@ -6,10 +6,44 @@
  * @date 2025-8-10
  */
 
+// 由 gen_lvgl_binding.py 生成的配置（摇树模式下只保留被脚本引用的字体、--trace 时启用追踪），
+// 须先于其他头文件包含，使 lv_bindings_trace.h 等看到同样的配置
+#if defined(__has_include)
+#if __has_include("lv_bindings_gen_conf.h")
+#include "lv_bindings_gen_conf.h"
+#endif
+#endif
 #include "lv_bindings_misc.h"
 #include "lv_bindings.h"
+#include "lv_bindings_msgq.h"
+#include "lv_bindings_sched.h"
+#include "lv_bindings_trace.h"
 #include <stdlib.h>
+#include <string.h>
 #include "uthash.h"
+#include "utlist.h"
+#ifndef LV_BINDING_FONT_FILTER
+#define LV_BINDING_FONT_FILTER 0
+#endif
+#ifndef LV_BINDING_GLYPH_CACHE_SIZE
+#define LV_BINDING_GLYPH_CACHE_SIZE 64 // lv_font_load 加载的每个字体的字形描述缓存条目数，必须为 2 的幂，0 表示不缓存
+#endif
+#if (LV_BINDING_GLYPH_CACHE_SIZE & (LV_BINDING_GLYPH_CACHE_SIZE - 1)) != 0
+#error "LV_BINDING_GLYPH_CACHE_SIZE must be a power of two"
+#endif
+#ifndef LV_BINDING_FONT_USE_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define LV_BINDING_FONT_USE_MMAP 1 // lv_font_load 映射主机文件，字形位图直接引用映射，不复制到内存
+#else
+#define LV_BINDING_FONT_USE_MMAP 0 // lv_font_load 通过 lv_binfont_create 读入 LVGL 堆，路径需带盘符
+#endif
+#endif
+#if LV_BINDING_FONT_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 /********************************** 错误处理辅助函数 **********************************/
 static jerry_value_t throw_error(const char *message)
 {
@@ -17,6 +51,126 @@ static jerry_value_t throw_error(const char *message)
     return jerry_throw_value(error_obj, true);
 }
 
+/********************************** 绑定上下文 **********************************/
+#ifndef LV_BINDING_CTX_CHUNK_SIZE
+#define LV_BINDING_CTX_CHUNK_SIZE 2048
+#endif
+
+// 上下文内存块，上下文拥有的所有记录都从这里分配，销毁时整块释放
+typedef struct binding_arena_chunk_t
+{
+    struct binding_arena_chunk_t *next;
+    size_t used;
+    size_t size;
+    uint8_t data[];
+} binding_arena_chunk_t;
+
+// 已释放记录组成的空闲链表，同类记录大小相同可直接复用
+typedef struct binding_free_slot_t
+{
+    struct binding_free_slot_t *next;
+} binding_free_slot_t;
+
+typedef struct callback_map_t callback_map_t;
+typedef struct timer_js_data_t timer_js_data_t;
+typedef struct style_js_data_t style_js_data_t;
+typedef struct promise_js_data_t promise_js_data_t;
+typedef struct font_ref_t font_ref_t;
+
+struct LVBindingContext
+{
+    callback_map_t *callback_table;
+    timer_js_data_t *timers;
+    style_js_data_t *styles;
+    promise_js_data_t *promises; // 尚未兑现的 lv_timer_delay / lv_anim_async
+    font_ref_t *font_refs;       // lv_font_load 加载的字体引用
+    binding_arena_chunk_t *chunks;
+    binding_free_slot_t *free_callbacks;
+    binding_free_slot_t *free_timers;
+    binding_free_slot_t *free_styles;
+    binding_free_slot_t *free_promises;
+    binding_free_slot_t *free_font_refs;
+    jerry_value_t msgq_handler; // 跨线程消息的 JS 处理函数
+    bool has_msgq_handler;
+    bool dying; // 在回调分发期间被销毁，等最外层分发结束后再释放
+    LVBindingContext_t *prev, *next;
+};
+
+// 默认上下文，未切换上下文时所有资源归它所有（utlist 双向链表要求表头的 prev 指向表尾）
+static LVBindingContext_t default_ctx = {.prev = &default_ctx};
+static LVBindingContext_t *current_ctx = &default_ctx;
+// 所有存活的上下文，事件分发时依次查找
+static LVBindingContext_t *ctx_list = &default_ctx;
+// 正在进行的回调分发层数，不为 0 时销毁上下文只做标记
+static uint32_t dispatch_depth = 0;
+
+static void binding_dispatch_enter(void);
+static void binding_dispatch_leave(void);
+
+/**
+ * @brief 使上下文资源对应的 JS 包装对象失效：清零 __ptr 并释放持有的引用
+ */
+static void invalidate_js_wrapper(jerry_value_t wrapper)
+{
+    if (jerry_value_is_object(wrapper))
+    {
+        jerry_value_t ptr_prop = jerry_string_sz("__ptr");
+        jerry_value_t ptr_val = jerry_number(0);
+        jerry_value_free(jerry_object_set(wrapper, ptr_prop, ptr_val));
+        jerry_value_free(ptr_prop);
+        jerry_value_free(ptr_val);
+    }
+    jerry_value_free(wrapper);
+}
+
+/**
+ * @brief 从上下文中分配一条记录（已清零）
+ * @param ctx 绑定上下文
+ * @param size 记录大小
+ * @param free_list 该类记录的空闲链表
+ */
+static void *binding_ctx_alloc(LVBindingContext_t *ctx, size_t size, binding_free_slot_t **free_list)
+{
+    if (*free_list)
+    {
+        binding_free_slot_t *slot = *free_list;
+        *free_list = slot->next;
+        memset(slot, 0, size);
+        return slot;
+    }
+
+    size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    binding_arena_chunk_t *chunk = ctx->chunks;
+    if (!chunk || chunk->used + size > chunk->size)
+    {
+        size_t chunk_size = size > LV_BINDING_CTX_CHUNK_SIZE ? size : LV_BINDING_CTX_CHUNK_SIZE;
+        chunk = (binding_arena_chunk_t *)malloc(sizeof(binding_arena_chunk_t) + chunk_size);
+        if (!chunk)
+        {
+            return NULL;
+        }
+        chunk->used = 0;
+        chunk->size = chunk_size;
+        chunk->next = ctx->chunks;
+        ctx->chunks = chunk;
+    }
+
+    void *p = chunk->data + chunk->used;
+    chunk->used += size;
+    memset(p, 0, size);
+    return p;
+}
+
+/**
+ * @brief 将记录归还到空闲链表，内存在上下文销毁时统一释放
+ */
+static void binding_ctx_free(void *p, binding_free_slot_t **free_list)
+{
+    binding_free_slot_t *slot = (binding_free_slot_t *)p;
+    slot->next = *free_list;
+    *free_list = slot;
+}
+
 /********************************** 回调系统 **********************************/
 #define MAX_CALLBACKS_PER_KEY 8
 
@@ -28,15 +182,67 @@ typedef struct
 } callback_key_t;
 
 // 回调映射表结构体，支持多个 JS 回调
-typedef struct
+struct callback_map_t
 {
     callback_key_t key;
     jerry_value_t callbacks[MAX_CALLBACKS_PER_KEY];
     int callback_count;
+    LVBindingContext_t *ctx;
+    lv_event_dsc_t *event_dsc;  // lv_event_handler 的挂载，多个上下文共用同一键时只有一个条目持有
+    lv_event_dsc_t *delete_dsc; // 对象删除时清理本条目
     UT_hash_handle hh;
-} callback_map_t;
+};
+
+/**
+ * @brief 在其他存活的上下文中查找相同键的条目
+ */
+static callback_map_t *find_sibling_callback_entry(const callback_map_t *entry)
+{
+    for (LVBindingContext_t *ctx = ctx_list; ctx; ctx = ctx->next)
+    {
+        if (ctx == entry->ctx)
+            continue;
+        callback_map_t *sibling = NULL;
+        HASH_FIND(hh, ctx->callback_table, &entry->key, sizeof(callback_key_t), sibling);
+        if (sibling)
+            return sibling;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 释放回调条目
+ * @param entry 回调条目
+ * @param obj_alive 对象是否仍然存在，存在时需要从对象上摘除 LVGL 回调
+ */
+static void release_callback_entry(callback_map_t *entry, bool obj_alive)
+{
+    LVBindingContext_t *ctx = entry->ctx;
+
+    for (int i = 0; i < entry->callback_count; i++)
+    {
+        jerry_value_free(entry->callbacks[i]);
+    }
+    // 条目可能在分发过程中被注销，清零后分发循环会自然结束
+    entry->callback_count = 0;
+
+    if (obj_alive)
+    {
+        if (entry->event_dsc)
+        {
+            // 其他上下文还在使用同一键时，把挂载转交给它
+            callback_map_t *sibling = find_sibling_callback_entry(entry);
+            if (sibling)
+                sibling->event_dsc = entry->event_dsc;
+            else
+                lv_obj_remove_event_dsc(entry->key.obj, entry->event_dsc);
+        }
+        lv_obj_remove_event_dsc(entry->key.obj, entry->delete_dsc);
+    }
 
-static callback_map_t *callback_table = NULL;
+    HASH_DEL(ctx->callback_table, entry);
+    binding_ctx_free(entry, &ctx->free_callbacks);
+}
 
 /**
  * @brief 处理 LVGL 的事件回调
@@ -48,16 +254,22 @@ static void lv_event_handler(lv_event_t *e)
     lv_obj_t *target = lv_event_get_target(e);
     int event = lv_event_get_code(e);
 
-    callback_map_t *entry = NULL;
-    callback_key_t key = {.obj = target, .event = event};
-    HASH_FIND(hh, callback_table, &key, sizeof(callback_key_t), entry);
-
-    if (!entry)
+    bool found = false;
+    for (LVBindingContext_t *ctx = ctx_list; ctx && !found; ctx = ctx->next)
     {
-        key.event = LV_EVENT_ALL;
-        HASH_FIND(hh, callback_table, &key, sizeof(callback_key_t), entry);
+        if (ctx->dying)
+            continue;
+        callback_map_t *entry = NULL;
+        callback_key_t key = {.obj = target, .event = event};
+        HASH_FIND(hh, ctx->callback_table, &key, sizeof(callback_key_t), entry);
+        if (!entry)
+        {
+            key.event = LV_EVENT_ALL;
+            HASH_FIND(hh, ctx->callback_table, &key, sizeof(callback_key_t), entry);
+        }
+        found = entry != NULL;
     }
-    if (!entry)
+    if (!found)
         return;
 
     // 创建事件对象
@@ -103,20 +315,55 @@ static void lv_event_handler(lv_event_t *e)
         jerry_value_free(prop_value);
     }
 
-    for (int i = 0; i < entry->callback_count; i++)
+    // 依次分发给每个上下文中注册的回调；回调可能注销条目，因此每次重新查找。
+    // 回调中销毁的上下文在分发结束前不会被释放，条目和链表指针始终有效，只跳过其余回调
+    LV_BINDING_TRACE_BEGIN(LV_BINDING_TRACE_ID_EVENT, event);
+    binding_dispatch_enter();
+    for (LVBindingContext_t *ctx = ctx_list; ctx; ctx = ctx->next)
     {
-        jerry_value_t ret = jerry_call(entry->callbacks[i], global, args, 1);
-        if (jerry_value_is_error(ret))
+        if (ctx->dying)
+            continue;
+        callback_map_t *entry = NULL;
+        callback_key_t key = {.obj = target, .event = event};
+        HASH_FIND(hh, ctx->callback_table, &key, sizeof(callback_key_t), entry);
+        if (!entry)
         {
-            // 处理错误
+            key.event = LV_EVENT_ALL;
+            HASH_FIND(hh, ctx->callback_table, &key, sizeof(callback_key_t), entry);
+        }
+        if (!entry)
+            continue;
+
+        for (int i = 0; i < entry->callback_count && !ctx->dying; i++)
+        {
+            jerry_value_t ret = lv_binding_sched_call(LV_BINDING_CALL_EVENT, entry->callbacks[i], global, args, 1);
+            if (jerry_value_is_error(ret))
+            {
+                // 处理错误
+            }
+            jerry_value_free(ret);
         }
-        jerry_value_free(ret);
     }
+    binding_dispatch_leave();
+    LV_BINDING_TRACE_END(LV_BINDING_TRACE_ID_EVENT);
 
     jerry_value_free(global);
     jerry_value_free(event_obj);
 }
 
+/**
+ * @brief 当 LVGL 对象被删除时，清理回调映射表中的对应条目
+ * @param e 由 LVGL 传入的事件对象，user_data 为对应的回调条目
+ */
+static void lv_obj_deleted_cb(lv_event_t *e)
+{
+    callback_map_t *entry = (callback_map_t *)lv_event_get_user_data(e);
+    if (entry)
+    {
+        release_callback_entry(entry, false);
+    }
+}
+
 /**
  * @brief 注册 LVGL 事件处理函数
  * @param args[0] lv_obj_t 对象
@@ -170,16 +417,25 @@ static jerry_value_t register_lv_event_handler(const jerry_call_info_t *call_inf
 
     callback_map_t *entry = NULL;
     callback_key_t key = {.obj = obj, .event = event};
-    HASH_FIND(hh, callback_table, &key, sizeof(callback_key_t), entry);
+    HASH_FIND(hh, current_ctx->callback_table, &key, sizeof(callback_key_t), entry);
 
     if (!entry)
     {
-        entry = malloc(sizeof(callback_map_t));
+        entry = binding_ctx_alloc(current_ctx, sizeof(callback_map_t), &current_ctx->free_callbacks);
+        if (!entry)
+        {
+            jerry_value_free(js_func);
+            return throw_error("Failed to allocate memory for callback");
+        }
         entry->key = key;
-        entry->callback_count = 0;
-        memset(entry->callbacks, 0, sizeof(entry->callbacks));
-        HASH_ADD(hh, callback_table, key, sizeof(callback_key_t), entry);
-        lv_obj_add_event_cb(obj, lv_event_handler, event, user_data);
+        entry->ctx = current_ctx;
+        // 同一键已由其他上下文挂载时不再重复挂载，避免回调被分发两次
+        if (!find_sibling_callback_entry(entry))
+        {
+            entry->event_dsc = lv_obj_add_event_cb(obj, lv_event_handler, event, user_data);
+        }
+        entry->delete_dsc = lv_obj_add_event_cb(obj, lv_obj_deleted_cb, LV_EVENT_DELETE, entry);
+        HASH_ADD(hh, current_ctx->callback_table, key, sizeof(callback_key_t), entry);
     }
 
     if (entry->callback_count < MAX_CALLBACKS_PER_KEY)
@@ -222,51 +478,47 @@ static jerry_value_t unregister_lv_event_handler(const jerry_call_info_t *call_i
 
     callback_map_t *entry = NULL;
     callback_key_t key = {.obj = obj, .event = event};
-    HASH_FIND(hh, callback_table, &key, sizeof(callback_key_t), entry);
+    HASH_FIND(hh, current_ctx->callback_table, &key, sizeof(callback_key_t), entry);
 
     if (entry)
     {
-        for (int i = 0; i < entry->callback_count; i++)
-        {
-            jerry_value_free(entry->callbacks[i]);
-        }
-        HASH_DEL(callback_table, entry);
-        free(entry);
+        release_callback_entry(entry, true);
     }
 
     return jerry_undefined();
 }
 
-/**
- * @brief 当 LVGL 对象被删除时，清理回调映射表中的对应条目
- * @param e 由 LVGL 传入的事件对象
- */
-static void lv_obj_deleted_cb(lv_event_t *e)
-{
-    lv_obj_t *obj = lv_event_get_target(e);
-    callback_map_t *cur, *tmp;
-    HASH_ITER(hh, callback_table, cur, tmp)
-    {
-        if (cur->key.obj == obj)
-        {
-            for (int i = 0; i < cur->callback_count; i++)
-            {
-                jerry_value_free(cur->callbacks[i]);
-            }
-            HASH_DEL(callback_table, cur);
-            free(cur);
-        }
-    }
-}
-
 /********************************** 定时器系统 **********************************/
 
 // 定时器数据结构
-typedef struct {
+struct timer_js_data_t {
     lv_timer_t* timer;
     jerry_value_t js_cb;
     jerry_value_t user_data;
-} timer_js_data_t;
+    jerry_value_t js_obj; // 返回给 JS 的定时器对象，释放时使其失效
+    int32_t repeat_count; // 剩余执行次数，与 LVGL 同步，-1 表示无限重复
+    LVBindingContext_t* ctx;
+    timer_js_data_t *prev, *next;
+};
+
+// 正在执行回调的定时器，回调内被释放时清空（lv_timer_handler 不会嵌套执行定时器）
+static timer_js_data_t* running_timer = NULL;
+
+/**
+ * @brief 释放定时器及其 JavaScript 资源
+ */
+static void release_timer_data(timer_js_data_t* timer_data) {
+    LVBindingContext_t* ctx = timer_data->ctx;
+    if (running_timer == timer_data) {
+        running_timer = NULL;
+    }
+    lv_timer_delete(timer_data->timer);
+    jerry_value_free(timer_data->js_cb);
+    jerry_value_free(timer_data->user_data);
+    invalidate_js_wrapper(timer_data->js_obj);
+    DL_DELETE(ctx->timers, timer_data);
+    binding_ctx_free(timer_data, &ctx->free_timers);
+}
 
 /**
  * @brief LVGL 定时器回调包装函数
@@ -279,12 +531,27 @@ static void lv_timer_js_cb(lv_timer_t* timer) {
         jerry_value_t global = jerry_current_realm();
         jerry_value_t args[1] = { data->user_data };
         
-        jerry_value_t ret = jerry_call(data->js_cb, global, args, 1);
+        // LVGL 在调用回调前递减重复次数
+        if (data->repeat_count > 0) {
+            data->repeat_count--;
+        }
+        running_timer = data;
+        LV_BINDING_TRACE_BEGIN(LV_BINDING_TRACE_ID_TIMER, 0);
+        binding_dispatch_enter();
+        jerry_value_t ret = lv_binding_sched_call(LV_BINDING_CALL_TIMER, data->js_cb, global, args, 1);
+        binding_dispatch_leave();
+        LV_BINDING_TRACE_END(LV_BINDING_TRACE_ID_TIMER);
         if (jerry_value_is_error(ret)) {
             
         }
         jerry_value_free(ret);
         jerry_value_free(global);
+
+        // 最后一次执行后释放定时器及回调；回调中已删除定时器或销毁上下文时 running_timer 已被清空
+        if (running_timer == data && data->repeat_count == 0) {
+            release_timer_data(data);
+        }
+        running_timer = NULL;
     }
 }
 
@@ -315,7 +582,7 @@ static jerry_value_t js_lv_timer_create(const jerry_call_info_t* call_info_p,
     jerry_value_t js_cb = jerry_value_copy(args[0]);
     
     // 创建定时器数据结构
-    timer_js_data_t* timer_data = (timer_js_data_t*)malloc(sizeof(timer_js_data_t));
+    timer_js_data_t* timer_data = (timer_js_data_t*)binding_ctx_alloc(current_ctx, sizeof(timer_js_data_t), &current_ctx->free_timers);
     if (!timer_data) {
         jerry_value_free(js_cb);
         jerry_value_free(user_data);
@@ -324,15 +591,24 @@ static jerry_value_t js_lv_timer_create(const jerry_call_info_t* call_info_p,
     
     timer_data->js_cb = js_cb;
     timer_data->user_data = user_data;
+    timer_data->js_obj = jerry_undefined();
+    timer_data->repeat_count = -1;
     
     // 创建 LVGL 定时器
     lv_timer_t* timer = lv_timer_create(lv_timer_js_cb, period, timer_data);
     if (!timer) {
-        free(timer_data);
+        jerry_value_free(js_cb);
+        jerry_value_free(user_data);
+        binding_ctx_free(timer_data, &current_ctx->free_timers);
         return throw_error("Failed to create timer");
     }
     
     timer_data->timer = timer;
+    timer_data->ctx = current_ctx;
+    DL_APPEND(current_ctx->timers, timer_data);
+    // 由 lv_timer_js_cb 在最后一次执行后通过 release_timer_data 删除，LVGL 不再自动删除，
+    // 避免定时器被删除后记录和 JS 回调无人释放
+    lv_timer_set_auto_delete(timer, false);
     
     // 创建 JavaScript 定时器对象
     jerry_value_t js_timer = jerry_object();
@@ -351,6 +627,7 @@ static jerry_value_t js_lv_timer_create(const jerry_call_info_t* call_info_p,
     jerry_value_free(type_prop);
     jerry_value_free(type_val);
     
+    timer_data->js_obj = jerry_value_copy(js_timer);
     return js_timer;
 }
 
@@ -378,20 +655,20 @@ static jerry_value_t js_lv_timer_delete(const jerry_call_info_t* call_info_p,
     
     lv_timer_t* timer = (lv_timer_t*)(uintptr_t)jerry_value_as_number(ptr_val);
     jerry_value_free(ptr_val);
+    if (!timer) {
+        return throw_error("Timer has been deleted");
+    }
     
     // 获取定时器数据
     timer_js_data_t* timer_data = (timer_js_data_t*)lv_timer_get_user_data(timer);
     
-    // 释放 JavaScript 资源
+    // 释放 JavaScript 资源并删除定时器
     if (timer_data) {
-        jerry_value_free(timer_data->js_cb);
-        jerry_value_free(timer_data->user_data);
-        free(timer_data);
+        release_timer_data(timer_data);
+    } else {
+        lv_timer_delete(timer);
     }
     
-    // 删除定时器
-    lv_timer_del(timer);
-    
     return jerry_undefined();
 }
 
@@ -420,6 +697,9 @@ static jerry_value_t js_lv_timer_set_period(const jerry_call_info_t* call_info_p
     
     lv_timer_t* timer = (lv_timer_t*)(uintptr_t)jerry_value_as_number(ptr_val);
     jerry_value_free(ptr_val);
+    if (!timer) {
+        return throw_error("Timer has been deleted");
+    }
     
     // 设置定时器周期
     uint32_t period = (uint32_t)jerry_value_as_number(args[1]);
@@ -453,10 +733,22 @@ static jerry_value_t js_lv_timer_set_repeat_count(const jerry_call_info_t* call_
     
     lv_timer_t* timer = (lv_timer_t*)(uintptr_t)jerry_value_as_number(ptr_val);
     jerry_value_free(ptr_val);
+    if (!timer) {
+        return throw_error("Timer has been deleted");
+    }
     
     // 设置定时器重复次数
     int32_t repeat_count = (int32_t)jerry_value_as_number(args[1]);
+    timer_js_data_t* timer_data = (timer_js_data_t*)lv_timer_get_user_data(timer);
+    if (timer_data && repeat_count == 0) {
+        // LVGL 不会再调用回调，立即释放
+        release_timer_data(timer_data);
+        return jerry_undefined();
+    }
     lv_timer_set_repeat_count(timer, repeat_count);
+    if (timer_data) {
+        timer_data->repeat_count = repeat_count < 0 ? -1 : repeat_count;
+    }
     
     return jerry_undefined();
 }
@@ -485,6 +777,9 @@ static jerry_value_t js_lv_timer_reset(const jerry_call_info_t* call_info_p,
     
     lv_timer_t* timer = (lv_timer_t*)(uintptr_t)jerry_value_as_number(ptr_val);
     jerry_value_free(ptr_val);
+    if (!timer) {
+        return throw_error("Timer has been deleted");
+    }
     
     // 重置定时器
     lv_timer_reset(timer);
@@ -581,6 +876,56 @@ jerry_value_t lv_color_to_js(lv_color_t color)
     return js_color;
 }
 /********************************** 特殊 LVGL 函数 **********************************/
+// 样式数据结构，style 必须是第一个成员，JS 对象中保存的 __ptr 即为其地址
+struct style_js_data_t
+{
+    lv_style_t style;
+    jerry_value_t js_obj; // 持有该样式的 JS 对象，释放时使其失效
+    LVBindingContext_t *ctx;
+    style_js_data_t *prev, *next;
+};
+
+/**
+ * @brief lv_obj_tree_walk 回调：从对象上摘除单个样式
+ */
+static lv_obj_tree_walk_res_t detach_style_cb(lv_obj_t *obj, void *user_data)
+{
+    lv_obj_remove_style(obj, (lv_style_t *)user_data, LV_PART_ANY | LV_STATE_ANY);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+/**
+ * @brief lv_obj_tree_walk 回调：从对象上摘除上下文拥有的全部样式
+ */
+static lv_obj_tree_walk_res_t detach_ctx_styles_cb(lv_obj_t *obj, void *user_data)
+{
+    LVBindingContext_t *ctx = (LVBindingContext_t *)user_data;
+    style_js_data_t *style_data;
+    DL_FOREACH(ctx->styles, style_data)
+    {
+        lv_obj_remove_style(obj, &style_data->style, LV_PART_ANY | LV_STATE_ANY);
+    }
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+/**
+ * @brief 释放样式
+ * @param detach 是否先从所有对象上摘除该样式（上下文销毁时已统一摘除）
+ */
+static void release_style_data(style_js_data_t *style_data, bool detach)
+{
+    LVBindingContext_t *ctx = style_data->ctx;
+    if (detach)
+    {
+        // 以 NULL 为起点时遍历所有显示器的全部屏幕
+        lv_obj_tree_walk(NULL, detach_style_cb, &style_data->style);
+    }
+    lv_style_reset(&style_data->style);
+    invalidate_js_wrapper(style_data->js_obj);
+    DL_DELETE(ctx->styles, style_data);
+    binding_ctx_free(style_data, &ctx->free_styles);
+}
+
 /**
  * @brief 样式初始化
  */
@@ -607,7 +952,7 @@ static jerry_value_t js_lv_style_init(const jerry_call_info_t *call_info_p,
 
     lv_style_t *style = NULL;
 
-    if (jerry_value_is_number(ptr_val))
+    if (jerry_value_is_number(ptr_val) && jerry_value_as_number(ptr_val) != 0)
     {
         // 已有指针的情况
         uintptr_t ptr = (uintptr_t)jerry_value_as_number(ptr_val);
@@ -615,13 +960,17 @@ static jerry_value_t js_lv_style_init(const jerry_call_info_t *call_info_p,
     }
     else
     {
-        // 没有指针的情况，分配新内存
-        style = (lv_style_t *)malloc(sizeof(lv_style_t));
-        if (!style)
+        // 没有指针的情况，从当前上下文分配新内存
+        jerry_value_free(ptr_val);
+        style_js_data_t *style_data = (style_js_data_t *)binding_ctx_alloc(current_ctx, sizeof(style_js_data_t), &current_ctx->free_styles);
+        if (!style_data)
         {
-            jerry_value_free(ptr_val);
             return throw_error("Failed to allocate memory for style");
         }
+        style_data->ctx = current_ctx;
+        style_data->js_obj = jerry_value_copy(args[0]);
+        DL_APPEND(current_ctx->styles, style_data);
+        style = &style_data->style;
 
         // 将指针保存回JS对象
         ptr_val = jerry_number((uintptr_t)style);
@@ -660,10 +1009,10 @@ static jerry_value_t js_lv_style_delete(const jerry_call_info_t *call_info_p,
     jerry_value_t ptr_val = jerry_object_get(args[0], ptr_prop);
     jerry_value_free(ptr_prop);
 
-    if (jerry_value_is_number(ptr_val))
+    if (jerry_value_is_number(ptr_val) && jerry_value_as_number(ptr_val) != 0)
     {
-        lv_style_t *style = (lv_style_t *)(uintptr_t)jerry_value_as_number(ptr_val);
-        free(style);
+        style_js_data_t *style_data = (style_js_data_t *)(uintptr_t)jerry_value_as_number(ptr_val);
+        release_style_data(style_data, true);
 
         // 清除指针引用
         ptr_prop = jerry_string_sz("__ptr");
@@ -675,107 +1024,1967 @@ static jerry_value_t js_lv_style_delete(const jerry_call_info_t *call_info_p,
     return jerry_undefined();
 }
 
-/********************************** 字体系统 **********************************/
-static void register_lvgl_fonts(void)
+/********************************** 批量查询 **********************************/
+/**
+ * @brief 包装 LVGL 对象，与生成的 lv_obj_t* 返回值格式一致
+ */
+static jerry_value_t wrap_lv_obj(lv_obj_t *obj)
 {
-    jerry_value_t global = jerry_current_realm();
+    jerry_value_t js_obj = jerry_object();
 
-    // 创建字体对象容器
-    jerry_value_t fonts = jerry_object();
+    jerry_value_t prop_name = jerry_string_sz("__ptr");
+    jerry_value_t prop_value = jerry_number((uintptr_t)obj);
+    jerry_value_free(jerry_object_set(js_obj, prop_name, prop_value));
+    jerry_value_free(prop_name);
+    jerry_value_free(prop_value);
 
-    // 注册Montserrat字体集
-#define REGISTER_FONT(name)                                                                   \
-    do                                                                                        \
-    {                                                                                         \
-        jerry_value_t font_obj = jerry_object();                                              \
-        jerry_object_set(font_obj, jerry_string_sz("__ptr"), jerry_number((uintptr_t)&name)); \
-        jerry_object_set(font_obj, jerry_string_sz("__type"), jerry_string_sz("lv_font"));    \
-        jerry_object_set(fonts, jerry_string_sz(#name), font_obj);                            \
-        jerry_value_free(font_obj);                                                           \
-    } while (0);
-#if LV_FONT_MONTSERRAT_8
-    REGISTER_FONT(lv_font_montserrat_8);
-#endif
-#if LV_FONT_MONTSERRAT_10
-    REGISTER_FONT(lv_font_montserrat_10);
-#endif
-#if LV_FONT_MONTSERRAT_12
-    REGISTER_FONT(lv_font_montserrat_12);
-#endif
-#if LV_FONT_MONTSERRAT_14
-    REGISTER_FONT(lv_font_montserrat_14);
-#endif
-#if LV_FONT_MONTSERRAT_16
-    REGISTER_FONT(lv_font_montserrat_16);
-#endif
-#if LV_FONT_MONTSERRAT_18
-    REGISTER_FONT(lv_font_montserrat_18);
-#endif
-#if LV_FONT_MONTSERRAT_20
-    REGISTER_FONT(lv_font_montserrat_20);
-#endif
-#if LV_FONT_MONTSERRAT_22
-    REGISTER_FONT(lv_font_montserrat_22);
-#endif
-#if LV_FONT_MONTSERRAT_24
-    REGISTER_FONT(lv_font_montserrat_24);
-#endif
-#if LV_FONT_MONTSERRAT_26
-    REGISTER_FONT(lv_font_montserrat_26);
-#endif
-#if LV_FONT_MONTSERRAT_28
-    REGISTER_FONT(lv_font_montserrat_28);
+    prop_name = jerry_string_sz("__class");
+    prop_value = jerry_string_sz("lv_obj");
+    jerry_value_free(jerry_object_set(js_obj, prop_name, prop_value));
+    jerry_value_free(prop_name);
+    jerry_value_free(prop_value);
+
+    return js_obj;
+}
+
+/**
+ * @brief 从 JS 对象中取出 LVGL 对象指针
+ * @return 对象指针，没有有效 __ptr 时返回 NULL
+ */
+static lv_obj_t *get_lv_obj_ptr(jerry_value_t js_obj)
+{
+    if (!jerry_value_is_object(js_obj))
+    {
+        return NULL;
+    }
+
+    jerry_value_t ptr_prop = jerry_string_sz("__ptr");
+    jerry_value_t ptr_val = jerry_object_get(js_obj, ptr_prop);
+    jerry_value_free(ptr_prop);
+    lv_obj_t *obj = jerry_value_is_number(ptr_val) ? (lv_obj_t *)(uintptr_t)jerry_value_as_number(ptr_val) : NULL;
+    jerry_value_free(ptr_val);
+    return obj;
+}
+
+/**
+ * @brief 获取全部子对象
+ * @param args[0] 父对象
+ * @return 子对象数组或抛出异常
+ */
+static jerry_value_t js_lv_obj_get_children(const jerry_call_info_t *call_info_p,
+                                            const jerry_value_t args[],
+                                            const jerry_length_t argc)
+{
+    lv_obj_t *parent = argc < 1 ? NULL : get_lv_obj_ptr(args[0]);
+    if (!parent)
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    uint32_t count = lv_obj_get_child_count(parent);
+    jerry_value_t result = jerry_array(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        jerry_value_t child = wrap_lv_obj(lv_obj_get_child(parent, (int32_t)i));
+        jerry_value_free(jerry_object_set_index(result, i, child));
+        jerry_value_free(child);
+    }
+    return result;
+}
+
+/**
+ * @brief 去掉类名的 "lv_" 前缀，不同 LVGL 版本的类名可能带或不带该前缀
+ */
+static const char *strip_class_prefix(const char *name)
+{
+    return strncmp(name, "lv_", 3) == 0 ? name + 3 : name;
+}
+
+/**
+ * @brief 深度优先收集类名匹配的后代对象
+ * @param class_name 已去掉 "lv_" 前缀的类名
+ */
+static void collect_descendants(lv_obj_t *parent, const char *class_name, jerry_value_t result, uint32_t *count)
+{
+    uint32_t child_count = lv_obj_get_child_count(parent);
+    for (uint32_t i = 0; i < child_count; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(parent, (int32_t)i);
+        const lv_obj_class_t *cls = lv_obj_get_class(child);
+        if (cls->name && strcmp(strip_class_prefix(cls->name), class_name) == 0)
+        {
+            jerry_value_t js_child = wrap_lv_obj(child);
+            jerry_value_free(jerry_object_set_index(result, (*count)++, js_child));
+            jerry_value_free(js_child);
+        }
+        collect_descendants(child, class_name, result, count);
+    }
+}
+
+/**
+ * @brief 查找类名匹配的全部后代对象（深度优先，按树中顺序）
+ * @param args[0] 根对象
+ * @param args[1] 类名，即 lv_obj_class_t 的 name，如 "slider"，可带 "lv_" 前缀
+ * @return 对象数组或抛出异常
+ */
+static jerry_value_t js_lv_obj_find_descendants(const jerry_call_info_t *call_info_p,
+                                                const jerry_value_t args[],
+                                                const jerry_length_t argc)
+{
+    lv_obj_t *root = argc < 2 ? NULL : get_lv_obj_ptr(args[0]);
+    if (!root || !jerry_value_is_string(args[1]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    char class_name[32];
+    jerry_size_t len = jerry_string_size(args[1], JERRY_ENCODING_UTF8);
+    if (len >= sizeof(class_name))
+    {
+        return throw_error("Class name too long");
+    }
+    jerry_string_to_buffer(args[1], JERRY_ENCODING_UTF8, (jerry_char_t *)class_name, len);
+    class_name[len] = '\0';
+    jerry_value_t result = jerry_array(0);
+    uint32_t count = 0;
+    collect_descendants(root, strip_class_prefix(class_name), result, &count);
+    return result;
+}
+
+// 可读取数值的控件，按 LVGL 类精确匹配
+typedef struct
+{
+    const lv_obj_class_t *cls;
+    int32_t (*get_value)(const lv_obj_t *obj);
+} widget_value_getter_t;
+
+#if LV_USE_DROPDOWN
+static int32_t get_dropdown_value(const lv_obj_t *obj)
+{
+    return (int32_t)lv_dropdown_get_selected(obj);
+}
 #endif
-#if LV_FONT_MONTSERRAT_30
-    REGISTER_FONT(lv_font_montserrat_30);
+#if LV_USE_ROLLER
+static int32_t get_roller_value(const lv_obj_t *obj)
+{
+    return (int32_t)lv_roller_get_selected(obj);
+}
 #endif
-#if LV_FONT_MONTSERRAT_32
-    REGISTER_FONT(lv_font_montserrat_32);
+#if LV_USE_SWITCH || LV_USE_CHECKBOX
+static int32_t get_checked_value(const lv_obj_t *obj)
+{
+    return lv_obj_has_state(obj, LV_STATE_CHECKED) ? 1 : 0;
+}
 #endif
-#if LV_FONT_MONTSERRAT_34
-    REGISTER_FONT(lv_font_montserrat_34);
+
+static const widget_value_getter_t widget_value_getters[] = {
+#if LV_USE_SLIDER
+    {&lv_slider_class, lv_slider_get_value},
 #endif
-#if LV_FONT_MONTSERRAT_36
-    REGISTER_FONT(lv_font_montserrat_36);
+#if LV_USE_BAR
+    {&lv_bar_class, lv_bar_get_value},
 #endif
-#if LV_FONT_MONTSERRAT_38
-    REGISTER_FONT(lv_font_montserrat_38);
+#if LV_USE_ARC
+    {&lv_arc_class, lv_arc_get_value},
 #endif
-#if LV_FONT_MONTSERRAT_40
-    REGISTER_FONT(lv_font_montserrat_40);
+#if LV_USE_SPINBOX
+    {&lv_spinbox_class, lv_spinbox_get_value},
 #endif
-#if LV_FONT_MONTSERRAT_42
-    REGISTER_FONT(lv_font_montserrat_42);
+#if LV_USE_DROPDOWN
+    {&lv_dropdown_class, get_dropdown_value},
 #endif
-#if LV_FONT_MONTSERRAT_44
-    REGISTER_FONT(lv_font_montserrat_44);
+#if LV_USE_ROLLER
+    {&lv_roller_class, get_roller_value},
 #endif
-#if LV_FONT_MONTSERRAT_46
-    REGISTER_FONT(lv_font_montserrat_46);
+#if LV_USE_SWITCH
+    {&lv_switch_class, get_checked_value},
 #endif
-#if LV_FONT_MONTSERRAT_48
-    REGISTER_FONT(lv_font_montserrat_48);
+#if LV_USE_CHECKBOX
+    {&lv_checkbox_class, get_checked_value},
 #endif
+    {NULL, NULL}};
 
-#undef REGISTER_FONT
-
-    // 将字体容器挂载到全局对象
-    jerry_object_set(global, jerry_string_sz("lv_font"), fonts);
-    jerry_value_free(fonts);
-    jerry_value_free(global);
+/**
+ * @brief 查找控件的数值读取函数
+ */
+static const widget_value_getter_t *find_widget_value_getter(const lv_obj_t *obj)
+{
+    for (const widget_value_getter_t *getter = widget_value_getters; getter->cls; getter++)
+    {
+        if (lv_obj_check_type(obj, getter->cls))
+        {
+            return getter;
+        }
+    }
+    return NULL;
 }
-/********************************** 绑定注册 **********************************/
 
-const LVBindingJerryscriptFuncEntry_t lvgl_binding_special_funcs[] = {
-    {"register_lv_event_handler", register_lv_event_handler},
-    {"unregister_lv_event_handler", unregister_lv_event_handler},
-    {"lv_style_init", js_lv_style_init},
-    {"lv_style_delete", js_lv_style_delete},
-    {"lv_timer_create", js_lv_timer_create},
-    {"lv_timer_delete", js_lv_timer_delete},
-    {"lv_timer_set_period", js_lv_timer_set_period},
-    {"lv_timer_set_repeat_count", js_lv_timer_set_repeat_count},
-    {"lv_timer_reset", js_lv_timer_reset}};
+/**
+ * @brief 批量读取控件的值
+ * @param args[0] 控件数组
+ * @return 与输入等长的数组：slider/bar/arc/spinbox 为数值，dropdown/roller 为选中项下标，
+ *         switch/checkbox 为 0/1，textarea 为文本，其他对象为 null
+ */
+static jerry_value_t js_lv_obj_get_values(const jerry_call_info_t *call_info_p,
+                                          const jerry_value_t args[],
+                                          const jerry_length_t argc)
+{
+    if (argc < 1 || !jerry_value_is_array(args[0]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    uint32_t count = jerry_array_length(args[0]);
+    jerry_value_t result = jerry_array(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        jerry_value_t item = jerry_object_get_index(args[0], i);
+        lv_obj_t *obj = get_lv_obj_ptr(item);
+        jerry_value_free(item);
+
+        jerry_value_t value;
+        const widget_value_getter_t *getter = obj ? find_widget_value_getter(obj) : NULL;
+        if (getter)
+        {
+            value = jerry_number(getter->get_value(obj));
+        }
+#if LV_USE_TEXTAREA
+        else if (obj && lv_obj_check_type(obj, &lv_textarea_class))
+        {
+            const char *text = lv_textarea_get_text(obj);
+            value = jerry_string_sz(text ? text : "");
+        }
+#endif
+        else
+        {
+            value = jerry_null();
+        }
+        jerry_value_free(jerry_object_set_index(result, i, value));
+        jerry_value_free(value);
+    }
+    return result;
+}
+
+/**
+ * @brief 批量读取控件的数值，结果写入 Int32Array，适合大量控件
+ * @param args[0] 控件数组
+ * @return 与输入等长的 Int32Array，不支持数值的对象为 0
+ */
+static jerry_value_t js_lv_obj_get_values_i32(const jerry_call_info_t *call_info_p,
+                                              const jerry_value_t args[],
+                                              const jerry_length_t argc)
+{
+    if (argc < 1 || !jerry_value_is_array(args[0]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    uint32_t count = jerry_array_length(args[0]);
+    jerry_value_t result = jerry_typedarray(JERRY_TYPEDARRAY_INT32, count);
+    if (jerry_value_is_error(result) || count == 0)
+    {
+        return result;
+    }
+
+    jerry_length_t offset = 0, length = 0;
+    jerry_value_t buffer = jerry_typedarray_buffer(result, &offset, &length);
+    if (jerry_value_is_error(buffer))
+    {
+        jerry_value_free(result);
+        return buffer;
+    }
+    uint8_t *data = jerry_arraybuffer_data(buffer);
+    if (!data)
+    {
+        jerry_value_free(buffer);
+        jerry_value_free(result);
+        return throw_error("Failed to access typed array buffer");
+    }
+    int32_t *values = (int32_t *)(data + offset);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        jerry_value_t item = jerry_object_get_index(args[0], i);
+        lv_obj_t *obj = get_lv_obj_ptr(item);
+        jerry_value_free(item);
+
+        const widget_value_getter_t *getter = obj ? find_widget_value_getter(obj) : NULL;
+        values[i] = getter ? getter->get_value(obj) : 0;
+    }
+    jerry_value_free(buffer);
+    return result;
+}
+
+/********************************** 异步操作 **********************************/
+// 异步操作数据结构，Promise 在定时器到期或动画结束时兑现
+struct promise_js_data_t
+{
+    jerry_value_t promise;
+    jerry_value_t exec_cb; // 动画每一步的 JS 回调，定时器为 undefined
+    lv_timer_t *timer;
+    bool anim_running;
+    bool settled;
+    bool releasing;
+    LVBindingContext_t *ctx;
+    promise_js_data_t *prev, *next;
+};
+
+/**
+ * @brief 兑现或拒绝 Promise，只生效一次
+ */
+static void settle_promise_data(promise_js_data_t *data, bool resolve, jerry_value_t value)
+{
+    if (data->settled)
+    {
+        return;
+    }
+    data->settled = true;
+    jerry_value_t ret = resolve ? jerry_promise_resolve(data->promise, value) : jerry_promise_reject(data->promise, value);
+    jerry_value_free(ret);
+}
+
+/**
+ * @brief 释放异步操作，仍在运行的定时器和动画一并删除
+ */
+static void release_promise_data(promise_js_data_t *data)
+{
+    LVBindingContext_t *ctx = data->ctx;
+    data->releasing = true;
+    if (data->timer)
+    {
+        lv_timer_delete(data->timer);
+    }
+    if (data->anim_running)
+    {
+        lv_anim_delete(data, NULL);
+    }
+    jerry_value_free(data->promise);
+    jerry_value_free(data->exec_cb);
+    DL_DELETE(ctx->promises, data);
+    binding_ctx_free(data, &ctx->free_promises);
+}
+
+/**
+ * @brief 从当前上下文创建异步操作
+ * @return 新的异步操作，Promise 创建失败或内存不足时返回 NULL 并通过 error 返回异常
+ */
+static promise_js_data_t *create_promise_data(jerry_value_t *error)
+{
+    jerry_value_t promise = jerry_promise();
+    if (jerry_value_is_error(promise))
+    {
+        *error = promise;
+        return NULL;
+    }
+
+    promise_js_data_t *data = (promise_js_data_t *)binding_ctx_alloc(current_ctx, sizeof(promise_js_data_t), &current_ctx->free_promises);
+    if (!data)
+    {
+        jerry_value_free(promise);
+        *error = throw_error("Failed to allocate memory for promise");
+        return NULL;
+    }
+    data->promise = promise;
+    data->exec_cb = jerry_undefined();
+    data->ctx = current_ctx;
+    DL_APPEND(current_ctx->promises, data);
+    return data;
+}
+
+/**
+ * @brief lv_timer_delay 的定时器回调，兑现 Promise 后释放
+ */
+static void promise_timer_cb(lv_timer_t *timer)
+{
+    promise_js_data_t *data = (promise_js_data_t *)lv_timer_get_user_data(timer);
+    settle_promise_data(data, true, jerry_undefined());
+    release_promise_data(data);
+}
+
+/**
+ * @brief 延时
+ * @param args[0] 延时（毫秒）
+ * @return 到期后兑现的 Promise
+ */
+static jerry_value_t js_lv_timer_delay(const jerry_call_info_t *call_info_p,
+                                       const jerry_value_t args[],
+                                       const jerry_length_t argc)
+{
+    if (argc < 1 || !jerry_value_is_number(args[0]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    jerry_value_t error;
+    promise_js_data_t *data = create_promise_data(&error);
+    if (!data)
+    {
+        return error;
+    }
+
+    data->timer = lv_timer_create(promise_timer_cb, (uint32_t)jerry_value_as_number(args[0]), data);
+    if (!data->timer)
+    {
+        release_promise_data(data);
+        return throw_error("Failed to create timer");
+    }
+    lv_timer_set_repeat_count(data->timer, 1);
+    lv_timer_set_auto_delete(data->timer, false);
+
+    return jerry_value_copy(data->promise);
+}
+
+/**
+ * @brief lv_anim_async 的动画回调，把当前值交给 JS
+ */
+static void promise_anim_exec_cb(lv_anim_t *a, int32_t value)
+{
+    promise_js_data_t *data = (promise_js_data_t *)lv_anim_get_user_data(a);
+    if (!jerry_value_is_function(data->exec_cb))
+    {
+        return;
+    }
+
+    jerry_value_t global = jerry_current_realm();
+    jerry_value_t args[1] = {jerry_number(value)};
+    LV_BINDING_TRACE_BEGIN(LV_BINDING_TRACE_ID_ANIM, 0);
+    binding_dispatch_enter();
+    jerry_value_t ret = lv_binding_sched_call(LV_BINDING_CALL_ANIM, data->exec_cb, global, args, 1);
+    binding_dispatch_leave();
+    LV_BINDING_TRACE_END(LV_BINDING_TRACE_ID_ANIM);
+    if (jerry_value_is_error(ret))
+    {
+        // 处理错误
+    }
+    jerry_value_free(ret);
+    jerry_value_free(args[0]);
+    jerry_value_free(global);
+}
+
+static void promise_anim_completed_cb(lv_anim_t *a)
+{
+    promise_js_data_t *data = (promise_js_data_t *)lv_anim_get_user_data(a);
+    settle_promise_data(data, true, jerry_undefined());
+}
+
+/**
+ * @brief 动画被删除（包括正常结束）时释放，提前删除时拒绝 Promise
+ */
+static void promise_anim_deleted_cb(lv_anim_t *a)
+{
+    promise_js_data_t *data = (promise_js_data_t *)lv_anim_get_user_data(a);
+    if (data->releasing)
+    {
+        return;
+    }
+    data->anim_running = false;
+    if (!data->settled)
+    {
+        jerry_value_t reason = jerry_error_sz(JERRY_ERROR_COMMON, (const jerry_char_t *)"Animation deleted");
+        settle_promise_data(data, false, reason);
+        jerry_value_free(reason);
+    }
+    release_promise_data(data);
+}
+
+/**
+ * @brief 读取对象中的数值选项
+ */
+static int32_t get_number_option(jerry_value_t options, const char *name, int32_t default_value)
+{
+    jerry_value_t prop = jerry_string_sz(name);
+    jerry_value_t val = jerry_object_get(options, prop);
+    int32_t result = jerry_value_is_number(val) ? (int32_t)jerry_value_as_number(val) : default_value;
+    jerry_value_free(val);
+    jerry_value_free(prop);
+    return result;
+}
+
+/**
+ * @brief 根据名称选择动画曲线
+ */
+static lv_anim_path_cb_t get_anim_path(jerry_value_t options)
+{
+    static const struct
+    {
+        const char *name;
+        lv_anim_path_cb_t path;
+    } paths[] = {
+        {"linear", lv_anim_path_linear},
+        {"ease_in", lv_anim_path_ease_in},
+        {"ease_out", lv_anim_path_ease_out},
+        {"ease_in_out", lv_anim_path_ease_in_out},
+        {"overshoot", lv_anim_path_overshoot},
+        {"bounce", lv_anim_path_bounce},
+        {"step", lv_anim_path_step},
+    };
+
+    lv_anim_path_cb_t result = lv_anim_path_linear;
+    jerry_value_t prop = jerry_string_sz("path");
+    jerry_value_t val = jerry_object_get(options, prop);
+    if (jerry_value_is_string(val))
+    {
+        char name[16];
+        jerry_size_t len = jerry_string_to_buffer(val, JERRY_ENCODING_UTF8, (jerry_char_t *)name, sizeof(name) - 1);
+        name[len] = '\0';
+        for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++)
+        {
+            if (strcmp(name, paths[i].name) == 0)
+            {
+                result = paths[i].path;
+                break;
+            }
+        }
+    }
+    jerry_value_free(val);
+    jerry_value_free(prop);
+    return result;
+}
+
+/**
+ * @brief 启动动画
+ * @param args[0] 选项对象 {exec, start, end, duration, delay, path}
+ *                exec 为每一步的回调 function(value)，path 为曲线名称（linear、ease_in、ease_out、ease_in_out、overshoot、bounce、step）
+ * @return 动画结束时兑现、被提前删除时拒绝的 Promise
+ */
+static jerry_value_t js_lv_anim_async(const jerry_call_info_t *call_info_p,
+                                      const jerry_value_t args[],
+                                      const jerry_length_t argc)
+{
+    if (argc < 1 || !jerry_value_is_object(args[0]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    jerry_value_t exec_prop = jerry_string_sz("exec");
+    jerry_value_t exec_cb = jerry_object_get(args[0], exec_prop);
+    jerry_value_free(exec_prop);
+    if (!jerry_value_is_function(exec_cb))
+    {
+        jerry_value_free(exec_cb);
+        return throw_error("Invalid exec callback");
+    }
+
+    jerry_value_t error;
+    promise_js_data_t *data = create_promise_data(&error);
+    if (!data)
+    {
+        jerry_value_free(exec_cb);
+        return error;
+    }
+    data->exec_cb = exec_cb;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, data);
+    lv_anim_set_user_data(&a, data);
+    lv_anim_set_values(&a, get_number_option(args[0], "start", 0), get_number_option(args[0], "end", 0));
+    lv_anim_set_duration(&a, (uint32_t)get_number_option(args[0], "duration", 0));
+    lv_anim_set_delay(&a, (uint32_t)get_number_option(args[0], "delay", 0));
+    lv_anim_set_path_cb(&a, get_anim_path(args[0]));
+    lv_anim_set_custom_exec_cb(&a, promise_anim_exec_cb);
+    lv_anim_set_completed_cb(&a, promise_anim_completed_cb);
+    lv_anim_set_deleted_cb(&a, promise_anim_deleted_cb);
+
+    if (!lv_anim_start(&a))
+    {
+        release_promise_data(data);
+        return throw_error("Failed to start animation");
+    }
+    data->anim_running = true;
+
+    return jerry_value_copy(data->promise);
+}
+
+/********************************** 跨线程消息 **********************************/
+static lv_timer_t *msgq_timer = NULL;
+
+/**
+ * @brief 将一条跨线程消息交给当前上下文的 JS 处理函数
+ * @param msg 消息
+ * @param user_data 当前上下文
+ */
+static void msgq_dispatch_cb(const LVBindingMsgqMessage_t *msg, void *user_data)
+{
+    LVBindingContext_t *ctx = (LVBindingContext_t *)user_data;
+    if (!ctx->has_msgq_handler)
+    {
+        return;
+    }
+
+    jerry_value_t args[2];
+    args[0] = jerry_number(msg->topic);
+    if (msg->type == LV_BINDING_MSGQ_BYTES)
+    {
+        args[1] = jerry_arraybuffer(msg->len);
+        jerry_arraybuffer_write(args[1], 0, msg->data.bytes, msg->len);
+    }
+    else
+    {
+        args[1] = jerry_number(msg->data.number);
+    }
+
+    // 处理函数可能在回调中被替换，调用期间持有一份引用
+    jerry_value_t handler = jerry_value_copy(ctx->msgq_handler);
+    jerry_value_t global = jerry_current_realm();
+    LV_BINDING_TRACE_BEGIN(LV_BINDING_TRACE_ID_MSGQ, (int32_t)msg->topic);
+    jerry_value_t ret = lv_binding_sched_call(LV_BINDING_CALL_MSGQ, handler, global, args, 2);
+    LV_BINDING_TRACE_END(LV_BINDING_TRACE_ID_MSGQ);
+    if (jerry_value_is_error(ret))
+    {
+        // 处理错误
+    }
+    jerry_value_free(ret);
+    jerry_value_free(global);
+    jerry_value_free(handler);
+    jerry_value_free(args[0]);
+    jerry_value_free(args[1]);
+}
+
+/**
+ * @brief 在 UI 线程中按预算批量处理跨线程消息
+ * @note 当前上下文没有处理函数时消息留在队列中，队列满后新投递的消息计入丢弃数
+ */
+static void msgq_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    LVBindingContext_t *ctx = current_ctx;
+    uint32_t budget = lv_binding_msgq_get_budget();
+
+    // 处理函数可能取消自己或销毁自己的上下文，此后剩余的消息留给下一次处理
+    binding_dispatch_enter();
+    for (uint32_t i = 0; i < budget && ctx->has_msgq_handler && !ctx->dying; i++)
+    {
+        if (!lv_binding_msgq_drain(msgq_dispatch_cb, ctx, 1))
+        {
+            break;
+        }
+    }
+    binding_dispatch_leave();
+}
+
+/**
+ * @brief 设置跨线程消息的处理函数
+ * @param args[0] JavaScript 函数 (topic, value)，value 为数值或 ArrayBuffer；传入 undefined/null 取消
+ * @return 无返回或抛出异常
+ */
+static jerry_value_t js_lv_msgq_set_handler(const jerry_call_info_t *call_info_p,
+                                            const jerry_value_t args[],
+                                            const jerry_length_t argc)
+{
+    if (argc < 1 || !(jerry_value_is_function(args[0]) || jerry_value_is_undefined(args[0]) || jerry_value_is_null(args[0])))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    if (current_ctx->has_msgq_handler)
+    {
+        jerry_value_free(current_ctx->msgq_handler);
+        current_ctx->has_msgq_handler = false;
+    }
+    if (jerry_value_is_function(args[0]))
+    {
+        current_ctx->msgq_handler = jerry_value_copy(args[0]);
+        current_ctx->has_msgq_handler = true;
+    }
+
+    return jerry_undefined();
+}
+
+/**
+ * @brief 设置每次最多处理的跨线程消息数
+ * @param args[0] 消息数
+ * @return 无返回或抛出异常
+ */
+static jerry_value_t js_lv_msgq_set_budget(const jerry_call_info_t *call_info_p,
+                                           const jerry_value_t args[],
+                                           const jerry_length_t argc)
+{
+    if (argc < 1 || !jerry_value_is_number(args[0]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    lv_binding_msgq_set_budget((uint32_t)jerry_value_as_number(args[0]));
+    return jerry_undefined();
+}
+
+/********************************** 字体加载 **********************************/
+// 已加载的二进制字体，按路径共享并引用计数
+typedef bool (*font_get_glyph_dsc_cb_t)(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letter_next);
+
+#if LV_BINDING_GLYPH_CACHE_SIZE
+// 字形描述缓存条目，按 (letter, letter_next) 直接映射
+typedef struct
+{
+    uint32_t letter;
+    uint32_t letter_next;
+    bool valid;
+    bool found;
+    lv_font_glyph_dsc_t dsc;
+} glyph_cache_entry_t;
+#endif
+
+#if LV_BINDING_FONT_USE_MMAP
+typedef struct mapped_font_t mapped_font_t;
+#endif
+
+typedef struct
+{
+    char *path;
+    lv_font_t *font;
+#if LV_BINDING_FONT_USE_MMAP
+    mapped_font_t *mapped; // 映射加载时 font 指向其中的字体，为 NULL 时 font 由 LVGL 加载
+    void *map;             // 字体文件映射，保留到字体销毁
+    size_t map_size;
+#endif
+    uint32_t ref_count;
+    font_get_glyph_dsc_cb_t get_glyph_dsc; // 字体原本的查找函数
+    uint32_t cache_hits;
+    uint32_t cache_misses;
+#if LV_BINDING_GLYPH_CACHE_SIZE
+    glyph_cache_entry_t cache[LV_BINDING_GLYPH_CACHE_SIZE];
+#endif
+    UT_hash_handle hh;
+} loaded_font_t;
+
+// 上下文持有的一份字体引用
+struct font_ref_t
+{
+    loaded_font_t *entry;
+    jerry_value_t js_obj; // lv_font_load 返回的字体对象，释放时使其失效
+    LVBindingContext_t *ctx;
+    font_ref_t *prev, *next;
+};
+
+static loaded_font_t *loaded_fonts = NULL;
+// 所有字体（包括已释放的）的缓存统计
+static uint32_t glyph_cache_hits = 0;
+static uint32_t glyph_cache_misses = 0;
+
+/**
+ * @brief 创建 JS 字体对象
+ */
+static jerry_value_t create_font_object(const lv_font_t *font)
+{
+    jerry_value_t font_obj = jerry_object();
+
+    jerry_value_t prop_name = jerry_string_sz("__ptr");
+    jerry_value_t prop_value = jerry_number((uintptr_t)font);
+    jerry_value_free(jerry_object_set(font_obj, prop_name, prop_value));
+    jerry_value_free(prop_name);
+    jerry_value_free(prop_value);
+
+    prop_name = jerry_string_sz("__type");
+    prop_value = jerry_string_sz("lv_font");
+    jerry_value_free(jerry_object_set(font_obj, prop_name, prop_value));
+    jerry_value_free(prop_name);
+    jerry_value_free(prop_value);
+
+    return font_obj;
+}
+
+#if LV_BINDING_GLYPH_CACHE_SIZE
+/**
+ * @brief 带缓存的字形描述查找，替换已加载字体的 get_glyph_dsc
+ */
+static bool cached_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letter_next)
+{
+    loaded_font_t *entry = (loaded_font_t *)font->user_data;
+    glyph_cache_entry_t *slot = &entry->cache[(letter ^ (letter_next * 31u)) & (LV_BINDING_GLYPH_CACHE_SIZE - 1)];
+
+    if (slot->valid && slot->letter == letter && slot->letter_next == letter_next)
+    {
+        entry->cache_hits++;
+        glyph_cache_hits++;
+        *dsc = slot->dsc;
+        return slot->found;
+    }
+
+    entry->cache_misses++;
+    glyph_cache_misses++;
+    bool found = entry->get_glyph_dsc(font, dsc, letter, letter_next);
+    slot->letter = letter;
+    slot->letter_next = letter_next;
+    slot->valid = true;
+    slot->found = found;
+    slot->dsc = *dsc;
+    return found;
+}
+#endif
+
+#if LV_BINDING_FONT_USE_MMAP
+/********************************** 映射加载二进制字体 **********************************/
+// 映射加载的字体：字形描述和 cmap 表头在堆中，字形位图、cmap 列表和字距表直接引用映射
+struct mapped_font_t
+{
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_font_fmt_txt_cmap_t *cmaps;
+    lv_font_fmt_txt_glyph_dsc_t *glyph_dsc;
+    lv_font_fmt_txt_kern_pair_t kern_pair;
+    lv_font_fmt_txt_kern_classes_t kern_classes;
+};
+
+// 映射的文件内容
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+} binfont_map_t;
+
+// 字体头（lv_binfont_loader.c 中的 font_header_bin_t）的长度
+#define BINFONT_HEADER_SIZE 40
+
+/**
+ * @brief 取映射中 [offset, offset + len) 的数据，越界或未按 align 对齐时返回 NULL
+ */
+static const uint8_t *binfont_at(const binfont_map_t *m, size_t offset, size_t len, size_t align)
+{
+    if (offset > m->size || len > m->size - offset || ((uintptr_t)(m->data + offset) & (align - 1)) != 0)
+    {
+        return NULL;
+    }
+    return m->data + offset;
+}
+
+static uint16_t binfont_u16(const uint8_t *p)
+{
+    uint16_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint32_t binfont_u32(const uint8_t *p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief 检查 start 处的表头（长度 + 标签）
+ * @return 整个表（含 8 字节表头）的长度，标签不符或越界时返回 0
+ */
+static uint32_t binfont_table(const binfont_map_t *m, size_t start, const char *label)
+{
+    const uint8_t *p = binfont_at(m, start, 8, 1);
+    if (!p || memcmp(p + 4, label, 4) != 0)
+    {
+        return 0;
+    }
+    uint32_t len = binfont_u32(p);
+    return (len >= 8 && binfont_at(m, start, len, 1)) ? len : 0;
+}
+
+/**
+ * @brief 按位读取无符号数，高位在前，与 LVGL 的二进制字体加载器一致
+ */
+static uint32_t binfont_bits(const uint8_t *p, uint32_t *bit_pos, uint32_t n)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < n; i++, (*bit_pos)++)
+    {
+        value = (value << 1) | ((p[*bit_pos >> 3] >> (7 - (*bit_pos & 7))) & 1u);
+    }
+    return value;
+}
+
+static int32_t binfont_bits_signed(const uint8_t *p, uint32_t *bit_pos, uint32_t n)
+{
+    uint32_t value = binfont_bits(p, bit_pos, n);
+    if (n && n < 32 && (value & (1u << (n - 1))))
+    {
+        value |= ~0u << n;
+    }
+    return (int32_t)value;
+}
+
+/**
+ * @brief 解析 cmap 表，列表直接引用映射
+ * @return 表长度，失败返回 0
+ */
+static uint32_t binfont_parse_cmaps(mapped_font_t *mf, const binfont_map_t *m, size_t start)
+{
+    uint32_t len = binfont_table(m, start, "cmap");
+    const uint8_t *p = binfont_at(m, start + 8, 4, 1);
+    if (!len || !p)
+    {
+        return 0;
+    }
+    uint32_t count = binfont_u32(p);
+    const uint8_t *tables = binfont_at(m, start + 12, (size_t)count * 16, 1);
+    if (count == 0 || count >= 512 || !tables) // cmap_num 为 9 位
+    {
+        return 0;
+    }
+    mf->cmaps = (lv_font_fmt_txt_cmap_t *)calloc(count, sizeof(lv_font_fmt_txt_cmap_t));
+    if (!mf->cmaps)
+    {
+        return 0;
+    }
+    mf->dsc.cmaps = mf->cmaps;
+    mf->dsc.cmap_num = count;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint8_t *t = tables + i * 16;
+        size_t data = start + binfont_u32(t);
+        uint16_t entries = binfont_u16(t + 12);
+        lv_font_fmt_txt_cmap_t *cmap = &mf->cmaps[i];
+        cmap->range_start = binfont_u32(t + 4);
+        cmap->range_length = binfont_u16(t + 8);
+        cmap->glyph_id_start = binfont_u16(t + 10);
+        cmap->type = (lv_font_fmt_txt_cmap_type_t)t[14];
+
+        switch (t[14])
+        {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            cmap->glyph_id_ofs_list = binfont_at(m, data, entries, 1);
+            cmap->list_length = cmap->range_length;
+            if (!cmap->glyph_id_ofs_list)
+            {
+                return 0;
+            }
+            break;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+            break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+            cmap->unicode_list = (const uint16_t *)binfont_at(m, data, (size_t)entries * 2, 2);
+            cmap->list_length = entries;
+            if (!cmap->unicode_list)
+            {
+                return 0;
+            }
+            if (t[14] == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL)
+            {
+                cmap->glyph_id_ofs_list = binfont_at(m, data + (size_t)entries * 2, (size_t)entries * 2, 2);
+                if (!cmap->glyph_id_ofs_list)
+                {
+                    return 0;
+                }
+            }
+            break;
+        default:
+            return 0;
+        }
+    }
+    return len;
+}
+
+/**
+ * @brief 检查 cmap 映射到的字形编号都在 loca 表范围内，避免查找字形时越界
+ */
+static bool binfont_check_cmaps(const mapped_font_t *mf, uint32_t glyph_count)
+{
+    for (uint32_t i = 0; i < mf->dsc.cmap_num; i++)
+    {
+        const lv_font_fmt_txt_cmap_t *cmap = &mf->cmaps[i];
+        uint32_t max_id = cmap->glyph_id_start;
+        switch (cmap->type)
+        {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            for (uint32_t j = 0; j < cmap->list_length; j++)
+            {
+                uint32_t id = cmap->glyph_id_start + ((const uint8_t *)cmap->glyph_id_ofs_list)[j];
+                max_id = id > max_id ? id : max_id;
+            }
+            break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            for (uint32_t j = 0; j < cmap->list_length; j++)
+            {
+                uint32_t id = cmap->glyph_id_start + ((const uint16_t *)cmap->glyph_id_ofs_list)[j];
+                max_id = id > max_id ? id : max_id;
+            }
+            break;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+            max_id += cmap->range_length ? cmap->range_length - 1u : 0u;
+            break;
+        default:
+            max_id += cmap->list_length ? cmap->list_length - 1u : 0u;
+            break;
+        }
+        if (max_id >= glyph_count)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 解析 kern 表，字距数据直接引用映射
+ * @return 是否成功
+ */
+static bool binfont_parse_kern(mapped_font_t *mf, const binfont_map_t *m, size_t start, uint8_t glyph_id_format)
+{
+    const uint8_t *p = binfont_at(m, start + 8, 8, 1); // 格式（1 字节 + 3 字节填充）及其后的 4 字节
+    if (!binfont_table(m, start, "kern") || !p)
+    {
+        return false;
+    }
+
+    if (p[0] == 0) // 按字形对排序的字距表
+    {
+        uint32_t pair_cnt = binfont_u32(p + 4);
+        size_t ids_size = (size_t)pair_cnt * (glyph_id_format == 0 ? 2 : 4);
+        mf->kern_pair.glyph_ids = binfont_at(m, start + 16, ids_size, glyph_id_format == 0 ? 1 : 2);
+        mf->kern_pair.values = (const int8_t *)binfont_at(m, start + 16 + ids_size, pair_cnt, 1);
+        mf->kern_pair.pair_cnt = pair_cnt;
+        mf->kern_pair.glyph_ids_size = glyph_id_format;
+        mf->dsc.kern_dsc = &mf->kern_pair;
+        mf->dsc.kern_classes = 0;
+        return mf->kern_pair.glyph_ids && mf->kern_pair.values && glyph_id_format <= 1;
+    }
+    if (p[0] == 3) // 按字形分类的字距矩阵
+    {
+        size_t mapping_len = binfont_u16(p + 4);
+        mf->kern_classes.left_class_cnt = p[6];
+        mf->kern_classes.right_class_cnt = p[7];
+        mf->kern_classes.left_class_mapping = binfont_at(m, start + 16, mapping_len, 1);
+        mf->kern_classes.right_class_mapping = binfont_at(m, start + 16 + mapping_len, mapping_len, 1);
+        mf->kern_classes.class_pair_values = (const void *)binfont_at(m, start + 16 + mapping_len * 2,
+                                                                      (size_t)p[6] * p[7], 1);
+        mf->dsc.kern_dsc = &mf->kern_classes;
+        mf->dsc.kern_classes = 1;
+        return mf->kern_classes.left_class_mapping && mf->kern_classes.right_class_mapping &&
+               mf->kern_classes.class_pair_values;
+    }
+    return false;
+}
+
+/**
+ * @brief 按 LVGL 二进制字体格式（head、cmap、loca、glyf、kern 表）解析映射，构造 lv_font_fmt_txt 字体
+ * @return 是否成功；字形头部位数不是 8 的整数倍时位图不按字节对齐，无法直接引用映射，返回 false
+ */
+static bool binfont_parse(mapped_font_t *mf, const binfont_map_t *m)
+{
+    uint32_t head_len = binfont_table(m, 0, "head");
+    const uint8_t *head = binfont_at(m, 8, BINFONT_HEADER_SIZE, 1);
+    if (head_len < 8 + BINFONT_HEADER_SIZE || !head)
+    {
+        return false;
+    }
+    uint16_t tables_count = binfont_u16(head + 4);
+    int16_t ascent = (int16_t)binfont_u16(head + 8);
+    int16_t descent = (int16_t)binfont_u16(head + 10);
+    uint16_t default_advance_width = binfont_u16(head + 22);
+    uint16_t kerning_scale = binfont_u16(head + 24);
+    uint8_t index_to_loc_format = head[26];
+    uint8_t glyph_id_format = head[27];
+    uint8_t advance_width_format = head[28];
+    uint8_t bpp = head[29];
+    uint8_t xy_bits = head[30];
+    uint8_t wh_bits = head[31];
+    uint8_t advance_width_bits = head[32];
+    uint8_t compression_id = head[33];
+    uint32_t header_bits = advance_width_bits + 2u * xy_bits + 2u * wh_bits;
+    if ((bpp != 1 && bpp != 2 && bpp != 3 && bpp != 4 && bpp != 8) || compression_id > 2 || header_bits % 8 != 0 ||
+        xy_bits > 32 || wh_bits > 32 || advance_width_bits > 32)
+    {
+        return false;
+    }
+    uint32_t header_bytes = header_bits / 8;
+
+    size_t cmap_start = head_len;
+    uint32_t cmap_len = binfont_parse_cmaps(mf, m, cmap_start);
+    if (!cmap_len)
+    {
+        return false;
+    }
+
+    size_t loca_start = cmap_start + cmap_len;
+    uint32_t loca_len = binfont_table(m, loca_start, "loca");
+    const uint8_t *p = binfont_at(m, loca_start + 8, 4, 1);
+    if (!loca_len || !p || index_to_loc_format > 1)
+    {
+        return false;
+    }
+    uint32_t loca_count = binfont_u32(p);
+    size_t loca_entry = index_to_loc_format == 0 ? 2 : 4;
+    const uint8_t *loca = loca_count <= m->size / loca_entry ? binfont_at(m, loca_start + 12, loca_count * loca_entry, 1) : NULL;
+    if (!loca || loca_count == 0 || !binfont_check_cmaps(mf, loca_count))
+    {
+        return false;
+    }
+
+    size_t glyf_start = loca_start + loca_len;
+    uint32_t glyf_len = binfont_table(m, glyf_start, "glyf");
+    if (!glyf_len)
+    {
+        return false;
+    }
+    mf->glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)calloc(loca_count, sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    if (!mf->glyph_dsc)
+    {
+        return false;
+    }
+
+    // 字形 0 保留为空字形
+    for (uint32_t i = 1; i < loca_count; i++)
+    {
+        uint32_t offset = loca_entry == 2 ? binfont_u16(loca + i * 2) : binfont_u32(loca + i * 4);
+        uint32_t next = i + 1 < loca_count
+                            ? (loca_entry == 2 ? binfont_u16(loca + (i + 1) * 2) : binfont_u32(loca + (i + 1) * 4))
+                            : glyf_len;
+        if (next > glyf_len || offset > next || next - offset < header_bytes)
+        {
+            return false;
+        }
+
+        const uint8_t *glyph = m->data + glyf_start + offset;
+        uint32_t bit_pos = 0;
+        uint32_t adv_w = advance_width_bits ? binfont_bits(glyph, &bit_pos, advance_width_bits) : default_advance_width;
+        if (advance_width_format == 0)
+        {
+            adv_w *= 16; // 整数像素宽度，转换为 1/16 像素
+        }
+
+        lv_font_fmt_txt_glyph_dsc_t *gdsc = &mf->glyph_dsc[i];
+        gdsc->adv_w = adv_w;
+        gdsc->ofs_x = binfont_bits_signed(glyph, &bit_pos, xy_bits);
+        gdsc->ofs_y = binfont_bits_signed(glyph, &bit_pos, xy_bits);
+        gdsc->box_w = binfont_bits(glyph, &bit_pos, wh_bits);
+        gdsc->box_h = binfont_bits(glyph, &bit_pos, wh_bits);
+        gdsc->bitmap_index = offset + header_bytes;
+        if (gdsc->bitmap_index != offset + header_bytes) // 超出 bitmap_index 的位宽
+        {
+            return false;
+        }
+        if (compression_id == 0 &&
+            ((uint32_t)gdsc->box_w * gdsc->box_h * bpp + 7) / 8 > next - offset - header_bytes)
+        {
+            return false;
+        }
+    }
+
+    if (tables_count >= 4)
+    {
+        if (!binfont_parse_kern(mf, m, glyf_start + glyf_len, glyph_id_format))
+        {
+            return false;
+        }
+        mf->dsc.kern_scale = kerning_scale;
+    }
+
+    mf->dsc.glyph_bitmap = m->data + glyf_start;
+    mf->dsc.glyph_dsc = mf->glyph_dsc;
+    mf->dsc.bpp = bpp;
+    mf->dsc.bitmap_format = compression_id;
+
+    mf->font.dsc = &mf->dsc;
+    mf->font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    mf->font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    mf->font.line_height = ascent - descent;
+    mf->font.base_line = -descent;
+    mf->font.subpx = head[34];
+    mf->font.underline_position = (int8_t)binfont_u16(head + 36);
+    mf->font.underline_thickness = (int8_t)binfont_u16(head + 38);
+    return true;
+}
+
+static void free_mapped_font(mapped_font_t *mf)
+{
+    free(mf->cmaps);
+    free(mf->glyph_dsc);
+    free(mf);
+}
+#endif
+
+/**
+ * @brief 加载二进制字体
+ * @note 启用 LV_BINDING_FONT_USE_MMAP 时映射文件，映射保留到字体销毁；字形位图不按字节对齐等
+ *       无法直接引用映射的字体退回到 lv_binfont_create_from_buffer 复制加载（需要 LV_USE_FS_MEMFS）
+ */
+static bool load_binfont(loaded_font_t *entry, const char *path)
+{
+#if LV_BINDING_FONT_USE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+
+    binfont_map_t m = {(const uint8_t *)map, size};
+    mapped_font_t *mf = (mapped_font_t *)calloc(1, sizeof(mapped_font_t));
+    if (mf && binfont_parse(mf, &m))
+    {
+        entry->font = &mf->font;
+        entry->mapped = mf;
+        entry->map = map;
+        entry->map_size = size;
+        return true;
+    }
+    if (mf)
+    {
+        free_mapped_font(mf);
+    }
+
+#if LV_USE_FS_MEMFS
+    LV_LOG_WARN("font %s can not be memory-mapped, loading a copy", path);
+    entry->font = lv_binfont_create_from_buffer(map, (uint32_t)size);
+#else
+    LV_LOG_WARN("font %s can not be memory-mapped", path);
+#endif
+    munmap(map, size);
+    return entry->font != NULL;
+#else
+    entry->font = lv_binfont_create(path);
+    return entry->font != NULL;
+#endif
+}
+
+/**
+ * @brief 销毁 load_binfont 加载的字体，映射加载时解除映射
+ */
+static void unload_binfont(loaded_font_t *entry)
+{
+#if LV_BINDING_FONT_USE_MMAP
+    if (entry->mapped)
+    {
+        free_mapped_font(entry->mapped);
+        munmap(entry->map, entry->map_size);
+        return;
+    }
+#endif
+    lv_binfont_destroy(entry->font);
+}
+
+/**
+ * @brief 从注册表中移除并销毁字体
+ */
+static void destroy_loaded_font(loaded_font_t *entry)
+{
+    HASH_DEL(loaded_fonts, entry);
+    unload_binfont(entry);
+    free(entry->path);
+    free(entry);
+}
+
+/**
+ * @brief 释放上下文持有的一份字体引用，最后一份引用释放时销毁字体
+ */
+static void release_font_ref(font_ref_t *ref)
+{
+    LVBindingContext_t *ctx = ref->ctx;
+    loaded_font_t *entry = ref->entry;
+
+    invalidate_js_wrapper(ref->js_obj);
+    DL_DELETE(ctx->font_refs, ref);
+    binding_ctx_free(ref, &ctx->free_font_refs);
+
+    if (--entry->ref_count == 0)
+    {
+        destroy_loaded_font(entry);
+    }
+}
+
+/**
+ * @brief 根据 JS 字体对象查找已加载的字体
+ */
+static loaded_font_t *find_loaded_font(jerry_value_t font_obj)
+{
+    if (!jerry_value_is_object(font_obj))
+    {
+        return NULL;
+    }
+
+    jerry_value_t ptr_prop = jerry_string_sz("__ptr");
+    jerry_value_t ptr_val = jerry_object_get(font_obj, ptr_prop);
+    jerry_value_free(ptr_prop);
+    lv_font_t *font = jerry_value_is_number(ptr_val) ? (lv_font_t *)(uintptr_t)jerry_value_as_number(ptr_val) : NULL;
+    jerry_value_free(ptr_val);
+
+    loaded_font_t *entry, *tmp;
+    HASH_ITER(hh, loaded_fonts, entry, tmp)
+    {
+        if (font && entry->font == font)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 加载 LVGL 二进制字体（.bin），同一路径的字体在所有应用间共享
+ * @param args[0] 字体文件路径：启用 LV_BINDING_FONT_USE_MMAP 时为主机文件路径，否则为带盘符的
+ *                LVGL 文件系统路径（如 "A:/fonts/cn_16.bin"）
+ * @return 字体对象或抛出异常
+ * @note 映射加载时字形位图直接引用文件映射，不占用堆内存；字体的最后一份引用释放时解除映射
+ */
+static jerry_value_t js_lv_font_load(const jerry_call_info_t *call_info_p,
+                                     const jerry_value_t args[],
+                                     const jerry_length_t argc)
+{
+    if (argc < 1 || !jerry_value_is_string(args[0]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    jerry_size_t len = jerry_string_size(args[0], JERRY_ENCODING_UTF8);
+    char *path = (char *)malloc(len + 1);
+    if (!path)
+    {
+        return throw_error("Failed to allocate memory for font path");
+    }
+    jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)path, len);
+    path[len] = '\0';
+
+    loaded_font_t *entry = NULL;
+    HASH_FIND_STR(loaded_fonts, path, entry);
+    if (entry)
+    {
+        free(path);
+    }
+    else
+    {
+        entry = (loaded_font_t *)calloc(1, sizeof(loaded_font_t));
+        if (!entry)
+        {
+            free(path);
+            return throw_error("Failed to allocate memory for font");
+        }
+        if (!load_binfont(entry, path))
+        {
+            free(entry);
+            free(path);
+            return throw_error("Failed to load font");
+        }
+        entry->path = path;
+        entry->get_glyph_dsc = entry->font->get_glyph_dsc;
+#if LV_BINDING_GLYPH_CACHE_SIZE
+        entry->font->user_data = entry;
+        entry->font->get_glyph_dsc = cached_get_glyph_dsc;
+#endif
+        HASH_ADD_KEYPTR(hh, loaded_fonts, entry->path, len, entry);
+    }
+
+    font_ref_t *ref = (font_ref_t *)binding_ctx_alloc(current_ctx, sizeof(font_ref_t), &current_ctx->free_font_refs);
+    if (!ref)
+    {
+        if (entry->ref_count == 0)
+        {
+            destroy_loaded_font(entry);
+        }
+        return throw_error("Failed to allocate memory for font reference");
+    }
+    jerry_value_t font_obj = create_font_object(entry->font);
+    ref->entry = entry;
+    ref->js_obj = jerry_value_copy(font_obj);
+    ref->ctx = current_ctx;
+    DL_APPEND(current_ctx->font_refs, ref);
+    entry->ref_count++;
+
+    return font_obj;
+}
+
+/**
+ * @brief 释放 lv_font_load 加载的字体，所有引用都释放后字体才会被销毁
+ * @param args[0] 字体对象
+ * @return 无返回或抛出异常
+ */
+static jerry_value_t js_lv_font_free(const jerry_call_info_t *call_info_p,
+                                     const jerry_value_t args[],
+                                     const jerry_length_t argc)
+{
+    loaded_font_t *entry = argc < 1 ? NULL : find_loaded_font(args[0]);
+    if (!entry)
+    {
+        return throw_error("Font was not loaded with lv_font_load");
+    }
+
+    // 优先释放与传入对象对应的引用，使失效的正是这个字体对象
+    font_ref_t *ref, *match = NULL;
+    DL_FOREACH(current_ctx->font_refs, ref)
+    {
+        if (ref->entry != entry)
+        {
+            continue;
+        }
+        jerry_value_t same = jerry_binary_op(JERRY_BIN_OP_STRICT_EQUAL, ref->js_obj, args[0]);
+        bool is_same = jerry_value_is_true(same);
+        jerry_value_free(same);
+        if (is_same)
+        {
+            match = ref;
+            break;
+        }
+        if (!match)
+        {
+            match = ref;
+        }
+    }
+    if (!match)
+    {
+        return throw_error("Font is not owned by the current context");
+    }
+
+    release_font_ref(match);
+    return jerry_undefined();
+}
+
+/**
+ * @brief 获取字形描述缓存的命中统计
+ * @param args[0] （可选）lv_font_load 加载的字体对象，留空返回所有字体的合计
+ * @return {hits, misses, size} 或抛出异常
+ */
+static jerry_value_t js_lv_font_cache_stats(const jerry_call_info_t *call_info_p,
+                                            const jerry_value_t args[],
+                                            const jerry_length_t argc)
+{
+    uint32_t hits = glyph_cache_hits;
+    uint32_t misses = glyph_cache_misses;
+
+    if (argc >= 1 && !jerry_value_is_undefined(args[0]))
+    {
+        loaded_font_t *entry = find_loaded_font(args[0]);
+        if (!entry)
+        {
+            return throw_error("Font was not loaded with lv_font_load");
+        }
+        hits = entry->cache_hits;
+        misses = entry->cache_misses;
+    }
+
+    jerry_value_t stats = jerry_object();
+    jerry_value_t prop_name, prop_value;
+
+    prop_name = jerry_string_sz("hits");
+    prop_value = jerry_number(hits);
+    jerry_value_free(jerry_object_set(stats, prop_name, prop_value));
+    jerry_value_free(prop_name);
+    jerry_value_free(prop_value);
+
+    prop_name = jerry_string_sz("misses");
+    prop_value = jerry_number(misses);
+    jerry_value_free(jerry_object_set(stats, prop_name, prop_value));
+    jerry_value_free(prop_name);
+    jerry_value_free(prop_value);
+
+    prop_name = jerry_string_sz("size");
+    prop_value = jerry_number(LV_BINDING_GLYPH_CACHE_SIZE);
+    jerry_value_free(jerry_object_set(stats, prop_name, prop_value));
+    jerry_value_free(prop_name);
+    jerry_value_free(prop_value);
+
+    return stats;
+}
+
+#if LV_BINDING_TRACE && LV_BINDING_TRACE_USE_STDIO
+/********************************** 调用追踪 **********************************/
+/**
+ * @brief 将调用追踪写入文件（Chrome trace-event JSON）
+ * @param args[0] 输出文件路径
+ * @return 写入的事件数或抛出异常
+ */
+static jerry_value_t js_lv_trace_dump(const jerry_call_info_t *call_info_p,
+                                      const jerry_value_t args[],
+                                      const jerry_length_t argc)
+{
+    if (argc < 1 || !jerry_value_is_string(args[0]))
+    {
+        return throw_error("Invalid arguments");
+    }
+
+    char path[256];
+    jerry_size_t len = jerry_string_size(args[0], JERRY_ENCODING_UTF8);
+    if (len >= sizeof(path))
+    {
+        return throw_error("Path too long");
+    }
+    jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)path, len);
+    path[len] = '\0';
+
+    int32_t count = lv_binding_trace_dump(path);
+    if (count < 0)
+    {
+        return throw_error("Failed to write trace");
+    }
+    return jerry_number(count);
+}
+
+#endif
+/********************************** 绑定上下文管理 **********************************/
+/**
+ * @brief 释放上下文拥有的全部资源：摘除 LVGL 回调、删除定时器、重置样式，并整块释放内存
+ */
+static void release_binding_ctx(LVBindingContext_t *ctx)
+{
+    callback_map_t *entry, *entry_tmp;
+    HASH_ITER(hh, ctx->callback_table, entry, entry_tmp)
+    {
+        release_callback_entry(entry, true);
+    }
+
+    timer_js_data_t *timer_data, *timer_tmp;
+    DL_FOREACH_SAFE(ctx->timers, timer_data, timer_tmp)
+    {
+        release_timer_data(timer_data);
+    }
+
+    // 样式内存随上下文整块释放，先从仍存活的对象上摘除，避免对象引用已释放的样式
+    if (ctx->styles)
+    {
+        lv_obj_tree_walk(NULL, detach_ctx_styles_cb, ctx);
+    }
+    style_js_data_t *style_data, *style_tmp;
+    DL_FOREACH_SAFE(ctx->styles, style_data, style_tmp)
+    {
+        release_style_data(style_data, false);
+    }
+
+    // 未兑现的 Promise 保持挂起，应用已退出，不再调度它的后续任务
+    promise_js_data_t *promise_data, *promise_tmp;
+    DL_FOREACH_SAFE(ctx->promises, promise_data, promise_tmp)
+    {
+        release_promise_data(promise_data);
+    }
+
+    font_ref_t *font_ref, *font_ref_tmp;
+    DL_FOREACH_SAFE(ctx->font_refs, font_ref, font_ref_tmp)
+    {
+        release_font_ref(font_ref);
+    }
+
+    if (ctx->has_msgq_handler)
+    {
+        jerry_value_free(ctx->msgq_handler);
+        ctx->has_msgq_handler = false;
+    }
+
+    binding_arena_chunk_t *chunk = ctx->chunks;
+    while (chunk)
+    {
+        binding_arena_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    ctx->chunks = NULL;
+    ctx->free_callbacks = NULL;
+    ctx->free_timers = NULL;
+    ctx->free_styles = NULL;
+    ctx->free_promises = NULL;
+    ctx->free_font_refs = NULL;
+}
+
+/**
+ * @brief 释放上下文的资源，非默认上下文同时从链表移除并释放自身
+ */
+static void finalize_binding_ctx(LVBindingContext_t *ctx)
+{
+    release_binding_ctx(ctx);
+    ctx->dying = false;
+    if (ctx != &default_ctx)
+    {
+        DL_DELETE(ctx_list, ctx);
+        free(ctx);
+    }
+}
+
+/**
+ * @brief 开始一次回调分发
+ */
+static void binding_dispatch_enter(void)
+{
+    dispatch_depth++;
+}
+
+/**
+ * @brief 结束一次回调分发，最外层分发结束时释放期间被销毁的上下文
+ */
+static void binding_dispatch_leave(void)
+{
+    if (--dispatch_depth)
+    {
+        return;
+    }
+
+    LVBindingContext_t *ctx, *tmp;
+    DL_FOREACH_SAFE(ctx_list, ctx, tmp)
+    {
+        if (ctx->dying)
+        {
+            finalize_binding_ctx(ctx);
+        }
+    }
+}
+
+/**
+ * @brief 创建绑定上下文
+ * @return 新的上下文，内存不足时返回 NULL
+ */
+LVBindingContext_t *lv_binding_ctx_create(void)
+{
+    LVBindingContext_t *ctx = (LVBindingContext_t *)calloc(1, sizeof(LVBindingContext_t));
+    if (!ctx)
+    {
+        return NULL;
+    }
+    DL_APPEND(ctx_list, ctx);
+    return ctx;
+}
+
+/**
+ * @brief 销毁绑定上下文，释放它拥有的回调、定时器、样式、字体引用和未兑现的异步操作
+ * @note 样式会被重置、字体可能被销毁，调用前应先删除仍在使用它们的对象；
+ *       lv_timer_create、lv_style_init、lv_font_load 返回的 JS 对象会被置为失效（__ptr 为 0）。
+ *       在事件、定时器、动画或跨线程消息回调中调用时（如应用的退出按钮），上下文立即停止接收回调，
+ *       资源推迟到最外层回调返回后释放
+ * @param ctx 要销毁的上下文，传入默认上下文时只释放资源
+ */
+void lv_binding_ctx_destroy(LVBindingContext_t *ctx)
+{
+    if (!ctx || ctx->dying)
+    {
+        return;
+    }
+    if (current_ctx == ctx)
+    {
+        current_ctx = &default_ctx;
+    }
+    if (dispatch_depth)
+    {
+        ctx->dying = true;
+        return;
+    }
+    finalize_binding_ctx(ctx);
+}
+
+/**
+ * @brief 切换当前上下文，之后注册的回调、定时器和样式都归该上下文所有
+ * @param ctx 新的当前上下文，传入 NULL 表示默认上下文
+ * @return 之前的当前上下文
+ */
+LVBindingContext_t *lv_binding_ctx_set_current(LVBindingContext_t *ctx)
+{
+    LVBindingContext_t *prev = current_ctx;
+    current_ctx = ctx ? ctx : &default_ctx;
+    return prev;
+}
+
+/**
+ * @brief 获取当前上下文
+ */
+LVBindingContext_t *lv_binding_ctx_get_current(void)
+{
+    return current_ctx;
+}
+
+/********************************** 字体系统 **********************************/
+// 编译进固件的字体，lv_font.xxx 首次被访问时才创建对应的 JS 对象
+typedef struct
+{
+    const char *name;
+    const lv_font_t *font;
+} builtin_font_t;
+
+#if LV_BINDING_FONT_FILTER
+#define LV_BINDING_FONT_ENABLED(size) LV_BINDING_USE_FONT_MONTSERRAT_##size
+#else
+#define LV_BINDING_FONT_ENABLED(size) 1
+#endif
+#define BUILTIN_FONT(name) {#name, &name},
+static const builtin_font_t builtin_fonts[] = {
+#if LV_FONT_MONTSERRAT_8 && LV_BINDING_FONT_ENABLED(8)
+    BUILTIN_FONT(lv_font_montserrat_8)
+#endif
+#if LV_FONT_MONTSERRAT_10 && LV_BINDING_FONT_ENABLED(10)
+    BUILTIN_FONT(lv_font_montserrat_10)
+#endif
+#if LV_FONT_MONTSERRAT_12 && LV_BINDING_FONT_ENABLED(12)
+    BUILTIN_FONT(lv_font_montserrat_12)
+#endif
+#if LV_FONT_MONTSERRAT_14 && LV_BINDING_FONT_ENABLED(14)
+    BUILTIN_FONT(lv_font_montserrat_14)
+#endif
+#if LV_FONT_MONTSERRAT_16 && LV_BINDING_FONT_ENABLED(16)
+    BUILTIN_FONT(lv_font_montserrat_16)
+#endif
+#if LV_FONT_MONTSERRAT_18 && LV_BINDING_FONT_ENABLED(18)
+    BUILTIN_FONT(lv_font_montserrat_18)
+#endif
+#if LV_FONT_MONTSERRAT_20 && LV_BINDING_FONT_ENABLED(20)
+    BUILTIN_FONT(lv_font_montserrat_20)
+#endif
+#if LV_FONT_MONTSERRAT_22 && LV_BINDING_FONT_ENABLED(22)
+    BUILTIN_FONT(lv_font_montserrat_22)
+#endif
+#if LV_FONT_MONTSERRAT_24 && LV_BINDING_FONT_ENABLED(24)
+    BUILTIN_FONT(lv_font_montserrat_24)
+#endif
+#if LV_FONT_MONTSERRAT_26 && LV_BINDING_FONT_ENABLED(26)
+    BUILTIN_FONT(lv_font_montserrat_26)
+#endif
+#if LV_FONT_MONTSERRAT_28 && LV_BINDING_FONT_ENABLED(28)
+    BUILTIN_FONT(lv_font_montserrat_28)
+#endif
+#if LV_FONT_MONTSERRAT_30 && LV_BINDING_FONT_ENABLED(30)
+    BUILTIN_FONT(lv_font_montserrat_30)
+#endif
+#if LV_FONT_MONTSERRAT_32 && LV_BINDING_FONT_ENABLED(32)
+    BUILTIN_FONT(lv_font_montserrat_32)
+#endif
+#if LV_FONT_MONTSERRAT_34 && LV_BINDING_FONT_ENABLED(34)
+    BUILTIN_FONT(lv_font_montserrat_34)
+#endif
+#if LV_FONT_MONTSERRAT_36 && LV_BINDING_FONT_ENABLED(36)
+    BUILTIN_FONT(lv_font_montserrat_36)
+#endif
+#if LV_FONT_MONTSERRAT_38 && LV_BINDING_FONT_ENABLED(38)
+    BUILTIN_FONT(lv_font_montserrat_38)
+#endif
+#if LV_FONT_MONTSERRAT_40 && LV_BINDING_FONT_ENABLED(40)
+    BUILTIN_FONT(lv_font_montserrat_40)
+#endif
+#if LV_FONT_MONTSERRAT_42 && LV_BINDING_FONT_ENABLED(42)
+    BUILTIN_FONT(lv_font_montserrat_42)
+#endif
+#if LV_FONT_MONTSERRAT_44 && LV_BINDING_FONT_ENABLED(44)
+    BUILTIN_FONT(lv_font_montserrat_44)
+#endif
+#if LV_FONT_MONTSERRAT_46 && LV_BINDING_FONT_ENABLED(46)
+    BUILTIN_FONT(lv_font_montserrat_46)
+#endif
+#if LV_FONT_MONTSERRAT_48 && LV_BINDING_FONT_ENABLED(48)
+    BUILTIN_FONT(lv_font_montserrat_48)
+#endif
+    {NULL, NULL}};
+#undef BUILTIN_FONT
+#undef LV_BINDING_FONT_ENABLED
+
+/**
+ * @brief 按名称查找内置字体
+ * @param name JS 字符串
+ */
+static const lv_font_t *find_builtin_font(jerry_value_t name)
+{
+    if (!jerry_value_is_string(name))
+    {
+        return NULL;
+    }
+
+    char buf[32];
+    jerry_size_t len = jerry_string_size(name, JERRY_ENCODING_UTF8);
+    if (len >= sizeof(buf))
+    {
+        return NULL;
+    }
+    jerry_string_to_buffer(name, JERRY_ENCODING_UTF8, (jerry_char_t *)buf, len);
+    buf[len] = '\0';
+
+    for (const builtin_font_t *entry = builtin_fonts; entry->name; entry++)
+    {
+        if (strcmp(entry->name, buf) == 0)
+        {
+            return entry->font;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief lv_font 代理的 get 处理函数，首次访问时创建字体对象并缓存到目标对象上
+ * @param args[0] 目标对象
+ * @param args[1] 属性名
+ */
+static jerry_value_t font_proxy_get(const jerry_call_info_t *call_info_p,
+                                    const jerry_value_t args[],
+                                    const jerry_length_t argc)
+{
+    if (argc < 2)
+    {
+        return jerry_undefined();
+    }
+
+    jerry_value_t cached = jerry_object_get(args[0], args[1]);
+    if (!jerry_value_is_undefined(cached))
+    {
+        return cached;
+    }
+    jerry_value_free(cached);
+
+    const lv_font_t *font = find_builtin_font(args[1]);
+    if (!font)
+    {
+        return jerry_undefined();
+    }
+
+    jerry_value_t font_obj = create_font_object(font);
+    jerry_value_free(jerry_object_set(args[0], args[1], font_obj));
+    return font_obj;
+}
+
+/**
+ * @brief lv_font 代理的 ownKeys 处理函数，返回全部内置字体名，使 Object.keys 与 for...in
+ *        与一次性创建全部字体对象时的结果一致
+ * @param args[0] 目标对象
+ */
+static jerry_value_t font_proxy_own_keys(const jerry_call_info_t *call_info_p,
+                                         const jerry_value_t args[],
+                                         const jerry_length_t argc)
+{
+    if (argc < 1)
+    {
+        return jerry_array(0);
+    }
+
+    // 先取目标对象上已有的属性（已访问过的字体和脚本自行添加的属性），再补上未访问过的字体
+    jerry_value_t keys = jerry_object_property_names(args[0], JERRY_PROPERTY_FILTER_ALL);
+    if (jerry_value_is_error(keys))
+    {
+        return keys;
+    }
+    uint32_t count = jerry_array_length(keys);
+    for (const builtin_font_t *entry = builtin_fonts; entry->name; entry++)
+    {
+        jerry_value_t font_name = jerry_string_sz(entry->name);
+        jerry_value_t has_own = jerry_object_has_own(args[0], font_name);
+        if (!jerry_value_is_true(has_own))
+        {
+            jerry_value_free(jerry_object_set_index(keys, count++, font_name));
+        }
+        jerry_value_free(has_own);
+        jerry_value_free(font_name);
+    }
+    return keys;
+}
+
+/**
+ * @brief lv_font 代理的 getOwnPropertyDescriptor 处理函数，内置字体先创建并缓存到目标对象上，
+ *        再返回目标对象上的属性描述
+ * @param args[0] 目标对象
+ * @param args[1] 属性名
+ */
+static jerry_value_t font_proxy_get_own_property_descriptor(const jerry_call_info_t *call_info_p,
+                                                            const jerry_value_t args[],
+                                                            const jerry_length_t argc)
+{
+    if (argc < 2)
+    {
+        return jerry_undefined();
+    }
+
+    jerry_value_free(font_proxy_get(call_info_p, args, argc));
+
+    jerry_property_descriptor_t desc = jerry_property_descriptor();
+    jerry_value_t found = jerry_object_get_own_prop(args[0], args[1], &desc);
+    jerry_value_t result = jerry_value_is_true(found) ? jerry_property_descriptor_to_object(&desc) : jerry_undefined();
+    jerry_value_free(found);
+    jerry_property_descriptor_free(&desc);
+    return result;
+}
+
+/**
+ * @brief lv_font 代理的 has 处理函数，使 "name" in lv_font 对未访问过的字体也成立
+ * @param args[0] 目标对象
+ * @param args[1] 属性名
+ */
+static jerry_value_t font_proxy_has(const jerry_call_info_t *call_info_p,
+                                    const jerry_value_t args[],
+                                    const jerry_length_t argc)
+{
+    if (argc < 2)
+    {
+        return jerry_boolean(false);
+    }
+
+    if (find_builtin_font(args[1]))
+    {
+        return jerry_boolean(true);
+    }
+    return jerry_object_has(args[0], args[1]);
+}
+
+static void register_lvgl_fonts(void)
+{
+    jerry_value_t global = jerry_current_realm();
+
+    // 创建字体对象容器
+    jerry_value_t fonts = jerry_object();
+    jerry_value_t font_ns;
+
+    if (jerry_feature_enabled(JERRY_FEATURE_PROXY))
+    {
+        static const LVBindingJerryscriptFuncEntry_t font_proxy_traps[] = {
+            {"get", font_proxy_get},
+            {"has", font_proxy_has},
+            {"ownKeys", font_proxy_own_keys},
+            {"getOwnPropertyDescriptor", font_proxy_get_own_property_descriptor},
+        };
+
+        jerry_value_t handler = jerry_object();
+        for (size_t i = 0; i < sizeof(font_proxy_traps) / sizeof(font_proxy_traps[0]); i++)
+        {
+            jerry_value_t trap_name = jerry_string_sz(font_proxy_traps[i].name);
+            jerry_value_t trap = jerry_function_external(font_proxy_traps[i].handler);
+            jerry_value_free(jerry_object_set(handler, trap_name, trap));
+            jerry_value_free(trap_name);
+            jerry_value_free(trap);
+        }
+
+        font_ns = jerry_proxy(fonts, handler);
+        jerry_value_free(handler);
+    }
+    else
+    {
+        // 不支持 Proxy 时一次性创建全部字体对象
+        for (const builtin_font_t *entry = builtin_fonts; entry->name; entry++)
+        {
+            jerry_value_t font_name = jerry_string_sz(entry->name);
+            jerry_value_t font_obj = create_font_object(entry->font);
+            jerry_value_free(jerry_object_set(fonts, font_name, font_obj));
+            jerry_value_free(font_name);
+            jerry_value_free(font_obj);
+        }
+        font_ns = jerry_value_copy(fonts);
+    }
+
+    // 将字体容器挂载到全局对象
+    jerry_object_set(global, jerry_string_sz("lv_font"), font_ns);
+    jerry_value_free(font_ns);
+    jerry_value_free(fonts);
+    jerry_value_free(global);
+}
+/********************************** 绑定注册 **********************************/
+
+const LVBindingJerryscriptFuncEntry_t lvgl_binding_special_funcs[] = {
+    {"register_lv_event_handler", register_lv_event_handler},
+    {"unregister_lv_event_handler", unregister_lv_event_handler},
+    {"lv_style_init", js_lv_style_init},
+    {"lv_style_delete", js_lv_style_delete},
+    {"lv_timer_create", js_lv_timer_create},
+    {"lv_timer_delete", js_lv_timer_delete},
+    {"lv_timer_set_period", js_lv_timer_set_period},
+    {"lv_timer_set_repeat_count", js_lv_timer_set_repeat_count},
+    {"lv_timer_reset", js_lv_timer_reset},
+    {"lv_timer_delay", js_lv_timer_delay},
+    {"lv_anim_async", js_lv_anim_async},
+    {"lv_font_load", js_lv_font_load},
+    {"lv_font_free", js_lv_font_free},
+    {"lv_font_cache_stats", js_lv_font_cache_stats},
+    {"lv_obj_get_children", js_lv_obj_get_children},
+    {"lv_obj_find_descendants", js_lv_obj_find_descendants},
+    {"lv_obj_get_values", js_lv_obj_get_values},
+    {"lv_obj_get_values_i32", js_lv_obj_get_values_i32},
+#if LV_BINDING_TRACE && LV_BINDING_TRACE_USE_STDIO
+    {"lv_trace_dump", js_lv_trace_dump},
+#endif
+    {"lv_msgq_set_handler", js_lv_msgq_set_handler},
+    {"lv_msgq_set_budget", js_lv_msgq_set_budget}};
 
 void lv_binding_jerryscript_register_functions(const LVBindingJerryscriptFuncEntry_t *entry, const size_t funcs_count)
 {
@@ -794,7 +3003,11 @@ void lv_binding_jerryscript_register_functions(const LVBindingJerryscriptFuncEnt
 void lv_bindings_misc_init(void)
 {
     // 初始化函数
-    lv_obj_add_event_cb(lv_scr_act(), lv_obj_deleted_cb, LV_EVENT_DELETE, NULL);
     lv_binding_jerryscript_register_functions(lvgl_binding_special_funcs, sizeof(lvgl_binding_special_funcs) / sizeof(LVBindingJerryscriptFuncEntry_t));
     register_lvgl_fonts();
+    lv_binding_sched_init();
+    if (!msgq_timer)
+    {
+        msgq_timer = lv_timer_create(msgq_timer_cb, LV_BINDING_MSGQ_PERIOD, NULL);
+    }
 }
@@ -0,0 +1,175 @@
+﻿
+/**
+ * @file lv_bindings_msgq.c
+ * @brief 跨线程消息队列：传感器、网络等线程向 JS/LVGL 线程投递消息
+ * @author Sab1e
+ * @date 2026-10-18
+ *
+ * 基于每个槽位序号的有界环形队列（Vyukov），生产者之间通过 CAS 竞争写位置，
+ * 唯一的消费者（UI 线程）按序读取，全程无锁。槽位中保存的是“序号 - 槽位下标”，
+ * 这样静态清零的队列即为合法的初始状态，无需初始化。
+ */
+
+#include "lv_bindings_msgq.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#if (LV_BINDING_MSGQ_CAPACITY & (LV_BINDING_MSGQ_CAPACITY - 1)) != 0
+#error "LV_BINDING_MSGQ_CAPACITY must be a power of two"
+#endif
+#if LV_BINDING_MSGQ_PAYLOAD_SIZE > 255
+#error "LV_BINDING_MSGQ_PAYLOAD_SIZE must fit in uint8_t"
+#endif
+
+/********************************** 环形队列 **********************************/
+typedef struct
+{
+    atomic_size_t seq; // 序号 - 槽位下标
+    LVBindingMsgqMessage_t msg;
+} msgq_slot_t;
+
+#define MSGQ_MASK (LV_BINDING_MSGQ_CAPACITY - 1)
+
+static msgq_slot_t msgq_slots[LV_BINDING_MSGQ_CAPACITY];
+static atomic_size_t msgq_tail; // 生产者写位置
+static size_t msgq_head;        // 消费者读位置，只在 UI 线程访问
+static atomic_uint msgq_dropped;
+static atomic_uint msgq_budget = LV_BINDING_MSGQ_DEFAULT_BUDGET;
+
+static inline size_t msgq_slot_load_seq(size_t index)
+{
+    return atomic_load_explicit(&msgq_slots[index].seq, memory_order_acquire) + index;
+}
+
+static inline void msgq_slot_store_seq(size_t index, size_t seq)
+{
+    atomic_store_explicit(&msgq_slots[index].seq, seq - index, memory_order_release);
+}
+
+/**
+ * @brief 投递一条消息
+ * @return 成功返回 true，队列已满返回 false 并计入丢弃数
+ */
+static bool msgq_push(const LVBindingMsgqMessage_t *msg)
+{
+    size_t pos = atomic_load_explicit(&msgq_tail, memory_order_relaxed);
+    for (;;)
+    {
+        size_t index = pos & MSGQ_MASK;
+        intptr_t diff = (intptr_t)(msgq_slot_load_seq(index) - pos);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&msgq_tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                msgq_slots[index].msg = *msg;
+                msgq_slot_store_seq(index, pos + 1);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            atomic_fetch_add_explicit(&msgq_dropped, 1, memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&msgq_tail, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief 取出一条消息（仅消费者线程）
+ * @return 有消息返回 true
+ */
+static bool msgq_pop(LVBindingMsgqMessage_t *out)
+{
+    size_t index = msgq_head & MSGQ_MASK;
+    if (msgq_slot_load_seq(index) != msgq_head + 1)
+    {
+        return false;
+    }
+    *out = msgq_slots[index].msg;
+    msgq_slot_store_seq(index, msgq_head + LV_BINDING_MSGQ_CAPACITY);
+    msgq_head++;
+    return true;
+}
+
+/********************************** 对外接口 **********************************/
+/**
+ * @brief 投递数值消息（任意线程）
+ * @param topic 消息主题
+ * @param value 数值
+ * @return 成功返回 true，队列已满返回 false
+ */
+bool lv_binding_msgq_post_number(uint32_t topic, double value)
+{
+    LVBindingMsgqMessage_t msg = {.topic = topic, .type = LV_BINDING_MSGQ_NUMBER};
+    msg.data.number = value;
+    return msgq_push(&msg);
+}
+
+/**
+ * @brief 投递字节消息（任意线程）
+ * @param topic 消息主题
+ * @param data 数据
+ * @param len 数据长度，不能超过 LV_BINDING_MSGQ_PAYLOAD_SIZE
+ * @return 成功返回 true，队列已满或数据过长返回 false
+ */
+bool lv_binding_msgq_post_bytes(uint32_t topic, const void *data, size_t len)
+{
+    if (len > LV_BINDING_MSGQ_PAYLOAD_SIZE || (len && !data))
+    {
+        return false;
+    }
+    LVBindingMsgqMessage_t msg = {.topic = topic, .type = LV_BINDING_MSGQ_BYTES, .len = (uint8_t)len};
+    if (len)
+    {
+        memcpy(msg.data.bytes, data, len);
+    }
+    return msgq_push(&msg);
+}
+
+/**
+ * @brief 批量取出消息并交给 handler 处理（仅 UI 线程）
+ * @param handler 消息处理函数
+ * @param user_data 传给 handler 的用户数据
+ * @param max_count 本次最多处理的消息数
+ * @return 实际处理的消息数
+ */
+uint32_t lv_binding_msgq_drain(LVBindingMsgqHandler_t handler, void *user_data, uint32_t max_count)
+{
+    LVBindingMsgqMessage_t msg;
+    uint32_t count = 0;
+    while (count < max_count && msgq_pop(&msg))
+    {
+        if (handler)
+        {
+            handler(&msg, user_data);
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief 设置 UI 线程每次处理的消息数上限
+ */
+void lv_binding_msgq_set_budget(uint32_t budget)
+{
+    atomic_store_explicit(&msgq_budget, budget ? budget : 1, memory_order_relaxed);
+}
+
+uint32_t lv_binding_msgq_get_budget(void)
+{
+    return atomic_load_explicit(&msgq_budget, memory_order_relaxed);
+}
+
+/**
+ * @brief 获取因队列已满而被丢弃的消息数
+ */
+uint32_t lv_binding_msgq_get_dropped(void)
+{
+    return atomic_load_explicit(&msgq_dropped, memory_order_relaxed);
+}
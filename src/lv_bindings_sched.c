@@ -0,0 +1,297 @@
+﻿
+/**
+ * @file lv_bindings_sched.c
+ * @brief JS 调度：按帧预算执行 Promise 任务，并用看门狗限制单次回调的执行时间
+ * @author Sab1e
+ * @date 2026-10-18
+ *
+ * 所有从 LVGL 进入 JS 的调用都经过 lv_binding_sched_call，这里统计每帧 JS 占用的时间。
+ * Promise 任务由一个 lv_timer 执行，本帧 JS 耗时已超过预算时推迟到下一帧，避免掉帧。
+ * 看门狗挂在 JerryScript 的 halt 回调上，单次调用超过硬上限时中止执行并上报。
+ */
+
+#if !defined(LV_BINDING_CLOCK_US) && !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 199309L // clock_gettime，须在包含任何头文件之前定义
+#endif
+#include "lv_bindings_sched.h"
+#include <string.h>
+#if !defined(LV_BINDING_CLOCK_US) && (defined(__unix__) || defined(__APPLE__))
+#include <time.h>
+#endif
+
+#if LV_USE_LOG && LV_LOG_LEVEL <= LV_LOG_LEVEL_WARN
+#define SCHED_LOG_OVERRUN 1 // 没有设置上报函数时通过 LV_LOG_WARN 输出
+#else
+#define SCHED_LOG_OVERRUN 0
+#endif
+
+/********************************** 调度状态 **********************************/
+static uint32_t job_budget = LV_BINDING_JOB_BUDGET;
+static uint32_t watchdog_limit = LV_BINDING_WATCHDOG_LIMIT;
+static LVBindingOverrunCb_t overrun_cb = NULL;
+static void *overrun_user_data = NULL;
+static uint32_t overrun_count = 0;
+
+// 最外层调用的状态，嵌套调用（如回调中同步触发的事件）计入最外层
+static uint32_t call_depth = 0;
+static uint32_t call_start = 0;
+static uint32_t call_start_us = 0;
+static bool call_aborted = false;
+
+// 当前帧内 JS 的累计耗时
+static uint32_t frame_start = 0;
+static uint32_t frame_js_us = 0;
+
+static lv_timer_t *job_timer = NULL;
+
+#if SCHED_LOG_OVERRUN
+static const char *const call_source_names[] = {"event", "timer", "msgq", "anim", "jobs"};
+#endif
+
+/********************************** 时钟 **********************************/
+#ifndef LV_BINDING_CLOCK_US
+#if defined(__unix__) || defined(__APPLE__)
+static uint32_t sched_clock_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+#define LV_BINDING_CLOCK_US() sched_clock_us()
+#else
+#define LV_BINDING_CLOCK_US() (lv_tick_get() * 1000u) // 没有微秒时钟时退回到 LVGL 毫秒时钟
+#endif
+#endif
+
+/********************************** 看门狗 **********************************/
+/**
+ * @brief JerryScript 虚拟机定期调用的检查函数，超过硬上限时中止脚本
+ * @return undefined 继续执行，其他值中止执行
+ */
+static jerry_value_t sched_halt_cb(void *user_p)
+{
+    (void)user_p;
+    if (call_depth && watchdog_limit && lv_tick_elaps(call_start) >= watchdog_limit)
+    {
+        call_aborted = true;
+        return jerry_throw_abort(jerry_string_sz("Script execution timeout"), true);
+    }
+    return jerry_undefined();
+}
+
+#if SCHED_LOG_OVERRUN
+/**
+ * @brief 取 JS 函数名，用于日志
+ */
+static void sched_get_function_name(jerry_value_t func, char *buf, size_t size)
+{
+    jerry_size_t len = 0;
+    if (jerry_value_is_function(func))
+    {
+        jerry_value_t name_prop = jerry_string_sz("name");
+        jerry_value_t name_val = jerry_object_get(func, name_prop);
+        if (jerry_value_is_string(name_val))
+        {
+            len = jerry_string_to_buffer(name_val, JERRY_ENCODING_UTF8, (jerry_char_t *)buf, (jerry_size_t)(size - 1));
+        }
+        jerry_value_free(name_val);
+        jerry_value_free(name_prop);
+    }
+    if (len == 0)
+    {
+        strncpy(buf, "anonymous", size - 1);
+        len = (jerry_size_t)strlen(buf);
+    }
+    buf[len] = '\0';
+}
+#endif
+
+/**
+ * @brief 上报超时的回调，未设置上报函数时输出警告日志
+ */
+static void sched_report_overrun(LVBindingCallSource_t source, jerry_value_t func, uint32_t elapsed, bool aborted)
+{
+    overrun_count++;
+
+    if (overrun_cb)
+    {
+        LVBindingOverrunInfo_t info = {
+            .source = source,
+            .callback = func,
+            .elapsed_ms = elapsed,
+            .aborted = aborted,
+        };
+        overrun_cb(&info, overrun_user_data);
+        return;
+    }
+
+#if SCHED_LOG_OVERRUN
+    char name[32];
+    sched_get_function_name(func, name, sizeof(name));
+    LV_LOG_WARN("JS %s callback '%s' ran for %u ms%s", call_source_names[source], name, (unsigned)elapsed,
+                aborted ? " and was aborted" : "");
+#endif
+}
+
+/********************************** 帧预算 **********************************/
+/**
+ * @brief 进入新的一帧时清零 JS 耗时
+ */
+static void sched_roll_frame(void)
+{
+    if (lv_tick_elaps(frame_start) >= LV_BINDING_FRAME_PERIOD)
+    {
+        frame_start = lv_tick_get();
+        frame_js_us = 0;
+    }
+}
+
+/**
+ * @brief 开始一次调用
+ * @return 是否为最外层调用
+ */
+static bool sched_enter(void)
+{
+    if (call_depth++)
+    {
+        return false;
+    }
+    call_start = lv_tick_get();
+    call_start_us = LV_BINDING_CLOCK_US();
+    call_aborted = false;
+    return true;
+}
+
+/**
+ * @brief 结束一次调用，最外层调用结束时统计耗时并检查是否超时
+ */
+static void sched_leave(LVBindingCallSource_t source, jerry_value_t func, bool outermost)
+{
+    call_depth--;
+    if (!outermost)
+    {
+        return;
+    }
+
+    // 帧预算按微秒累计，否则不足 1 毫秒的回调都会被记为 0
+    uint32_t elapsed_us = LV_BINDING_CLOCK_US() - call_start_us;
+    uint32_t elapsed = lv_tick_elaps(call_start);
+    sched_roll_frame();
+    frame_js_us += elapsed_us;
+
+    if (call_aborted || (watchdog_limit && elapsed >= watchdog_limit))
+    {
+        sched_report_overrun(source, func, elapsed, call_aborted);
+    }
+}
+
+/**
+ * @brief 执行 Promise 任务，本帧预算已用完时推迟到下一帧
+ * @note 预算只在开始执行前检查，一旦开始就执行完整个队列，见 LV_BINDING_JOB_BUDGET
+ */
+static void job_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    sched_roll_frame();
+    if (call_depth || (job_budget && frame_js_us >= job_budget * 1000u))
+    {
+        return;
+    }
+
+    bool outermost = sched_enter();
+    jerry_value_t ret = jerry_run_jobs();
+    sched_leave(LV_BINDING_CALL_JOBS, jerry_undefined(), outermost);
+    jerry_value_free(ret);
+}
+
+/********************************** 对外接口 **********************************/
+/**
+ * @brief 获取微秒时钟，供帧预算统计与调用追踪共用
+ * @note 只用于计算时间差，数值约 71 分钟回绕一次
+ */
+uint32_t lv_binding_clock_us(void)
+{
+    return LV_BINDING_CLOCK_US();
+}
+
+/**
+ * @brief 初始化调度器，JerryScript 每次重新初始化后都需要调用以重新挂载看门狗
+ */
+void lv_binding_sched_init(void)
+{
+    if (!jerry_feature_enabled(JERRY_FEATURE_VM_HALT))
+    {
+        LV_LOG_WARN("JerryScript built without VM halt support, overrunning callbacks are reported but not aborted");
+    }
+    jerry_halt_handler(LV_BINDING_WATCHDOG_INTERVAL, sched_halt_cb, NULL);
+
+    if (!job_timer)
+    {
+        frame_start = lv_tick_get();
+        job_timer = lv_timer_create(job_timer_cb, LV_BINDING_JOB_PERIOD, NULL);
+    }
+}
+
+/**
+ * @brief 在看门狗保护下调用 JS 函数，用于所有从 LVGL 进入 JS 的回调
+ * @param source 调用来源，用于上报
+ * @param func JS 函数
+ * @param this_val this 值
+ * @param args 参数
+ * @param argc 参数个数
+ * @return jerry_call 的返回值，被看门狗中止时为 abort 异常
+ */
+jerry_value_t lv_binding_sched_call(LVBindingCallSource_t source, jerry_value_t func, jerry_value_t this_val,
+                                    const jerry_value_t args[], jerry_size_t argc)
+{
+    bool outermost = sched_enter();
+    jerry_value_t ret = jerry_call(func, this_val, args, argc);
+    sched_leave(source, func, outermost);
+    return ret;
+}
+
+/**
+ * @brief 设置每帧 JS 的时间预算（毫秒），超出后 Promise 任务推迟到下一帧，0 表示不限制
+ * @note 只控制是否开始执行任务队列，不会截断正在执行的队列
+ */
+void lv_binding_set_job_budget(uint32_t budget_ms)
+{
+    job_budget = budget_ms;
+}
+
+uint32_t lv_binding_get_job_budget(void)
+{
+    return job_budget;
+}
+
+/**
+ * @brief 设置单次回调的硬上限（毫秒），0 表示不限制
+ */
+void lv_binding_set_watchdog_limit(uint32_t limit_ms)
+{
+    watchdog_limit = limit_ms;
+}
+
+uint32_t lv_binding_get_watchdog_limit(void)
+{
+    return watchdog_limit;
+}
+
+/**
+ * @brief 设置超时上报函数
+ * @param cb 上报函数，传入 NULL 恢复为输出警告日志
+ * @param user_data 传给上报函数的用户数据
+ */
+void lv_binding_set_overrun_cb(LVBindingOverrunCb_t cb, void *user_data)
+{
+    overrun_cb = cb;
+    overrun_user_data = user_data;
+}
+
+/**
+ * @brief 获取累计的超时次数
+ */
+uint32_t lv_binding_get_overrun_count(void)
+{
+    return overrun_count;
+}
@@ -0,0 +1,268 @@
+﻿
+/**
+ * @file lv_bindings_trace.c
+ * @brief 绑定调用追踪：记录每次进入/离开绑定的时间，导出为 Chrome trace-event JSON
+ * @author Sab1e
+ * @date 2026-10-18
+ *
+ * 写入方通过原子自增抢占槽位，写完后发布槽位序号；导出时只读取序号完整且
+ * 读取前后未变化的记录，因此写入方无需加锁。缓冲写满后覆盖最早的记录。
+ * 导出的文件可直接在 chrome://tracing 或 Perfetto 中打开。
+ */
+
+#include "lv_bindings_trace.h"
+
+#if LV_BINDING_TRACE
+
+#include "lvgl.h"
+#include "lv_bindings_sched.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#if (LV_BINDING_TRACE_CAPACITY & (LV_BINDING_TRACE_CAPACITY - 1)) != 0
+#error "LV_BINDING_TRACE_CAPACITY must be a power of two"
+#endif
+
+/********************************** 时钟 **********************************/
+#ifndef LV_BINDING_TRACE_CLOCK_US
+#define LV_BINDING_TRACE_CLOCK_US() lv_binding_clock_us() // 与调度器共用微秒时钟
+#endif
+
+/********************************** 环形缓冲 **********************************/
+typedef struct
+{
+    atomic_uint seq; // 写入完成后的序号 + 1，0 表示空
+    uint32_t ts_us;
+    uint16_t id;
+    uint8_t phase; // 'B' 或 'E'
+    int32_t arg;
+} trace_record_t;
+
+#define TRACE_MASK (LV_BINDING_TRACE_CAPACITY - 1)
+
+static trace_record_t trace_records[LV_BINDING_TRACE_CAPACITY];
+static atomic_uint trace_head;
+static atomic_bool trace_enabled = true;
+
+static const char *const *trace_names = NULL;
+static uint32_t trace_name_count = 0;
+
+static const char *const builtin_trace_names[LV_BINDING_TRACE_ID_GENERATED] = {
+    [LV_BINDING_TRACE_ID_EVENT] = "lv_event_handler",
+    [LV_BINDING_TRACE_ID_TIMER] = "lv_timer_js_cb",
+    [LV_BINDING_TRACE_ID_MSGQ] = "msgq_dispatch_cb",
+    [LV_BINDING_TRACE_ID_ANIM] = "promise_anim_exec_cb",
+};
+
+/**
+ * @brief 写入一条记录
+ */
+static void trace_push(uint32_t id, uint8_t phase, int32_t arg)
+{
+    if (!atomic_load_explicit(&trace_enabled, memory_order_relaxed))
+    {
+        return;
+    }
+
+    uint32_t index = atomic_fetch_add_explicit(&trace_head, 1, memory_order_relaxed);
+    trace_record_t *record = &trace_records[index & TRACE_MASK];
+    atomic_store_explicit(&record->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    record->ts_us = LV_BINDING_TRACE_CLOCK_US();
+    record->id = (uint16_t)id;
+    record->phase = phase;
+    record->arg = arg;
+    atomic_store_explicit(&record->seq, index + 1, memory_order_release);
+}
+
+/**
+ * @brief 读取一条记录
+ * @return 记录完整且未被覆盖时返回 true
+ */
+static bool trace_read(uint32_t index, trace_record_t *out)
+{
+    trace_record_t *record = &trace_records[index & TRACE_MASK];
+    if (atomic_load_explicit(&record->seq, memory_order_acquire) != index + 1)
+    {
+        return false;
+    }
+    out->ts_us = record->ts_us;
+    out->id = record->id;
+    out->phase = record->phase;
+    out->arg = record->arg;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&record->seq, memory_order_relaxed) == index + 1;
+}
+
+static const char *trace_name(uint32_t id)
+{
+    if (id < LV_BINDING_TRACE_ID_GENERATED)
+    {
+        return builtin_trace_names[id] ? builtin_trace_names[id] : "unknown";
+    }
+    id -= LV_BINDING_TRACE_ID_GENERATED;
+    return id < trace_name_count ? trace_names[id] : "unknown";
+}
+
+/**
+ * @brief 向 buf 追加格式化文本，缓冲区写满时截断
+ * @return 新的长度，不超过 size - 1
+ */
+static size_t trace_append(char *buf, size_t size, size_t len, const char *fmt, ...)
+{
+    if (len + 1 >= size)
+    {
+        return len;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + len, size - len, fmt, ap);
+    va_end(ap);
+    if (n < 0)
+    {
+        buf[len] = '\0';
+        return len;
+    }
+    len += (size_t)n;
+    return len < size - 1 ? len : size - 1;
+}
+
+/********************************** 对外接口 **********************************/
+/**
+ * @brief 进入绑定
+ * @param id 绑定编号
+ * @param arg 附加参数，事件分发为事件码、跨线程消息为主题，导出到 args
+ */
+void lv_binding_trace_begin(uint32_t id, int32_t arg)
+{
+    trace_push(id, 'B', arg);
+}
+
+/**
+ * @brief 离开绑定
+ */
+void lv_binding_trace_end(uint32_t id)
+{
+    trace_push(id, 'E', 0);
+}
+
+/**
+ * @brief 注册生成的绑定名称表，由生成的 lv_binding_init 调用
+ */
+void lv_binding_trace_register_names(const char *const *names, uint32_t count)
+{
+    trace_names = names;
+    trace_name_count = count;
+}
+
+void lv_binding_trace_set_enabled(bool enabled)
+{
+    atomic_store_explicit(&trace_enabled, enabled, memory_order_relaxed);
+}
+
+/**
+ * @brief 丢弃已记录的数据（仅在没有其他线程写入时调用）
+ */
+void lv_binding_trace_clear(void)
+{
+    for (uint32_t i = 0; i < LV_BINDING_TRACE_CAPACITY; i++)
+    {
+        atomic_store_explicit(&trace_records[i].seq, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&trace_head, 0, memory_order_release);
+}
+
+/**
+ * @brief 以 Chrome trace-event JSON 格式输出缓冲中的记录
+ * @param write_cb 输出函数
+ * @param user_data 传给输出函数的用户数据
+ * @return 输出的事件数
+ * @note 缓冲回绕后开头可能缺少与 'E' 对应的 'B'，这些记录会被跳过
+ */
+uint32_t lv_binding_trace_write(LVBindingTraceWriteCb_t write_cb, void *user_data)
+{
+    uint32_t head = atomic_load_explicit(&trace_head, memory_order_acquire);
+    uint32_t start = head > LV_BINDING_TRACE_CAPACITY ? head - LV_BINDING_TRACE_CAPACITY : 0;
+
+    static const char prologue[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    write_cb(prologue, sizeof(prologue) - 1, user_data);
+
+    char line[256];
+    uint32_t count = 0;
+    uint32_t depth = 0;
+    bool have_base = false;
+    uint32_t base_ts = 0;
+    trace_record_t record;
+    for (uint32_t index = start; index != head; index++)
+    {
+        if (!trace_read(index, &record))
+        {
+            continue;
+        }
+        if (record.phase == 'E')
+        {
+            if (depth == 0)
+            {
+                continue;
+            }
+            depth--;
+        }
+        else
+        {
+            depth++;
+        }
+        if (!have_base)
+        {
+            base_ts = record.ts_us;
+            have_base = true;
+        }
+
+        // 名称写在记录末尾之前，过长时被截断也只影响名称本身，结尾的 "} 单独写出
+        size_t len = trace_append(line, sizeof(line), 0,
+                                  "%s\n{\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":1",
+                                  count ? "," : "",
+                                  record.id < LV_BINDING_TRACE_ID_GENERATED ? "callback" : "binding", record.phase,
+                                  (unsigned long)(uint32_t)(record.ts_us - base_ts));
+        if (record.phase == 'B' && (record.id == LV_BINDING_TRACE_ID_EVENT || record.id == LV_BINDING_TRACE_ID_MSGQ))
+        {
+            len = trace_append(line, sizeof(line), len, ",\"args\":{\"%s\":%ld}",
+                               record.id == LV_BINDING_TRACE_ID_EVENT ? "code" : "topic", (long)record.arg);
+        }
+        len = trace_append(line, sizeof(line), len, ",\"name\":\"%s", trace_name(record.id));
+        write_cb(line, len, user_data);
+        write_cb("\"}", 2, user_data);
+        count++;
+    }
+
+    static const char epilogue[] = "\n]}\n";
+    write_cb(epilogue, sizeof(epilogue) - 1, user_data);
+    return count;
+}
+
+#if LV_BINDING_TRACE_USE_STDIO
+static void trace_file_write_cb(const char *data, size_t len, void *user_data)
+{
+    fwrite(data, 1, len, (FILE *)user_data);
+}
+
+/**
+ * @brief 将缓冲中的记录写入文件
+ * @param path 输出文件路径
+ * @return 输出的事件数，无法打开文件时返回 -1
+ */
+int32_t lv_binding_trace_dump(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        return -1;
+    }
+    uint32_t count = lv_binding_trace_write(trace_file_write_cb, file);
+    fclose(file);
+    return (int32_t)count;
+}
+#endif
+
+#endif // LV_BINDING_TRACE